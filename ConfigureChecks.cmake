@@ -93,6 +93,22 @@ if(NOT HAVE_STD_ATOMIC)
   endif()
 endif()
 
+# Determine whether your compiler supports rvalue references.  The result is
+# installed with taglib_config.h, since it changes the public API.
+
+check_cxx_source_compiles("
+  #include <utility>
+  struct S {
+    S() {}
+    S(S &&) {}
+  };
+  int main() {
+    S s;
+    S t(std::move(s));
+    return 0;
+  }
+" TAGLIB_HAVE_RVALUE_REFERENCES)
+
 # Determine which kind of byte swap functions your compiler supports.
 
 check_cxx_source_compiles("
@@ -188,6 +204,34 @@ check_cxx_source_compiles("
   }
 " HAVE_ISO_STRDUP)
 
+# Determine whether your system supports positional reads and writes.
+# FileStream uses them instead of stdio if available.
+
+if(NOT WIN32)
+  check_cxx_source_compiles("
+    #include <unistd.h>
+    int main() {
+      char buf[1];
+      pread(0, buf, 1, 0);
+      pwrite(0, buf, 1, 0);
+      return 0;
+    }
+  " HAVE_PREAD)
+
+  # Linux can copy a range of a file in the kernel, or share the blocks on
+  # file systems with reflinks.  FileStream uses it to replace a file.
+
+  check_cxx_source_compiles("
+    #include <sys/types.h>
+    #include <unistd.h>
+    int main() {
+      loff_t in = 0, out = 0;
+      copy_file_range(0, &in, 1, &out, 1, 0);
+      return 0;
+    }
+  " HAVE_COPY_FILE_RANGE)
+endif()
+
 # Determine whether zlib is installed.
 
 if(NOT ZLIB_SOURCE)
@@ -209,3 +253,19 @@ if(BUILD_TESTS AND NOT BUILD_SHARED_LIBS)
   endif()
 endif()
 
+
+# Determine whether the test suite can start threads.
+
+if(BUILD_TESTS)
+  find_package(Threads)
+  set(CMAKE_REQUIRED_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+  check_cxx_source_compiles("
+    #include <thread>
+    int main() {
+      std::thread t([] {});
+      t.join();
+      return 0;
+    }
+  " HAVE_STD_THREAD)
+  unset(CMAKE_REQUIRED_LIBRARIES)
+endif()
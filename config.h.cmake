@@ -24,9 +24,18 @@
 /* Defined if your compiler supports ISO _strdup */
 #cmakedefine   HAVE_ISO_STRDUP 1
 
+/* Defined if your system supports pread() and pwrite() */
+#cmakedefine   HAVE_PREAD 1
+
+/* Defined if your system supports copy_file_range() */
+#cmakedefine   HAVE_COPY_FILE_RANGE 1
+
 /* Defined if zlib is installed */
 #cmakedefine   HAVE_ZLIB 1
 
+/* Defined if the tests can use std::thread */
+#cmakedefine   HAVE_STD_THREAD 1
+
 /* Indicates whether debug messages are shown even in release mode */
 #cmakedefine   TRACE_IN_RELEASE 1
 
@@ -38,6 +38,7 @@
 #include <id3v1tag.h>
 #include <id3v2header.h>
 #include <tpropertymap.h>
+#include <tpropertyhandlers.h>
 #include <tagutils.h>
 
 #include "apefile.h"
@@ -91,6 +92,8 @@ APE::File::File(FileName file, bool readProperties, Properties::ReadStyle) :
   TagLib::File(file),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -99,6 +102,8 @@ APE::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle) :
   TagLib::File(stream),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -143,6 +148,8 @@ bool APE::File::save()
     return false;
   }
 
+  SaveScope scope(this);
+
   // Update ID3v1 tag
 
   if(ID3v1Tag() && !ID3v1Tag()->isEmpty()) {
@@ -249,9 +256,9 @@ void APE::File::read(bool readProperties)
   if (!isValid())
     return;
 
-  // Look for an ID3v2 tag
+  // Look for ID3v2, ID3v1 and APE tags
 
-  d->ID3v2Location = Utils::findID3v2(this);
+  Utils::findTags(this, &d->ID3v2Location, &d->ID3v1Location, &d->APELocation);
 
   if(d->ID3v2Location >= 0) {
     seek(d->ID3v2Location);
@@ -259,17 +266,9 @@ void APE::File::read(bool readProperties)
     d->ID3v2Size = d->ID3v2Header->completeTagSize();
   }
 
-  // Look for an ID3v1 tag
-
-  d->ID3v1Location = Utils::findID3v1(this);
-
   if(d->ID3v1Location >= 0)
     d->tag.set(ApeID3v1Index, new ID3v1::Tag(this, d->ID3v1Location));
 
-  // Look for an APE tag
-
-  d->APELocation = Utils::findAPE(this, d->ID3v1Location);
-
   if(d->APELocation >= 0) {
     d->tag.set(ApeAPEIndex, new APE::Tag(this, d->APELocation));
     d->APESize = APETag()->footer()->completeTagSize();
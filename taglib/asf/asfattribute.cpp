@@ -24,6 +24,7 @@
  ***************************************************************************/
 
 #include <taglib.h>
+#include <tbytereader.h>
 #include <tdebug.h>
 #include <trefcounter.h>
 
@@ -177,29 +178,60 @@ ASF::Picture ASF::Attribute::toPicture() const
 }
 
 String ASF::Attribute::parse(ASF::File &f, int kind)
+{
+  // Find the size of the attribute from its header and parse it from memory.
+
+  const long start = f.tell();
+  unsigned int size;
+  if(kind == 0) {
+    const unsigned int nameLength = readWORD(&f);
+    f.seek(nameLength + 2, File::Current);
+    size = 2 + nameLength + 4 + readWORD(&f);
+  }
+  else {
+    const ByteVector header = f.readBlock(12);
+    size = 12 + header.toUShort(4, false) + header.toUInt(8, false);
+  }
+
+  // Numeric values are read by their type rather than by the size in the
+  // header, so read a few more bytes in case the two disagree.
+
+  size += 8;
+
+  f.seek(start);
+  const ByteVector data = f.readBlock(size);
+
+  Utils::ByteReader reader(data);
+  const String name = parse(reader, kind);
+  f.seek(start + static_cast<long>(reader.position()));
+
+  return name;
+}
+
+String ASF::Attribute::parse(Utils::ByteReader &reader, int kind)
 {
   unsigned int size, nameLength;
   String name;
   d->pictureValue = Picture::fromInvalid();
   // extended content descriptor
   if(kind == 0) {
-    nameLength = readWORD(&f);
-    name = readString(&f, nameLength);
-    d->type = ASF::Attribute::AttributeTypes(readWORD(&f));
-    size = readWORD(&f);
+    nameLength = reader.readUShort(false);
+    name = readString(reader, nameLength);
+    d->type = ASF::Attribute::AttributeTypes(reader.readUShort(false));
+    size = reader.readUShort(false);
   }
   // metadata & metadata library
   else {
-    int temp = readWORD(&f);
+    int temp = reader.readUShort(false);
     // metadata library
     if(kind == 2) {
       d->language = temp;
     }
-    d->stream = readWORD(&f);
-    nameLength = readWORD(&f);
-    d->type = ASF::Attribute::AttributeTypes(readWORD(&f));
-    size = readDWORD(&f);
-    name = readString(&f, nameLength);
+    d->stream = reader.readUShort(false);
+    nameLength = reader.readUShort(false);
+    d->type = ASF::Attribute::AttributeTypes(reader.readUShort(false));
+    size = reader.readUInt(false);
+    name = readString(reader, nameLength);
   }
 
   if(kind != 2 && size > 65535) {
@@ -208,33 +240,33 @@ String ASF::Attribute::parse(ASF::File &f, int kind)
 
   switch(d->type) {
   case WordType:
-    d->numericValue = readWORD(&f);
+    d->numericValue = reader.readUShort(false);
     break;
 
   case BoolType:
     if(kind == 0) {
-      d->numericValue = (readDWORD(&f) != 0);
+      d->numericValue = (reader.readUInt(false) != 0);
     }
     else {
-      d->numericValue = (readWORD(&f) != 0);
+      d->numericValue = (reader.readUShort(false) != 0);
     }
     break;
 
   case DWordType:
-    d->numericValue = readDWORD(&f);
+    d->numericValue = reader.readUInt(false);
     break;
 
   case QWordType:
-    d->numericValue = readQWORD(&f);
+    d->numericValue = reader.readULongLong(false);
     break;
 
   case UnicodeType:
-    d->stringValue = readString(&f, size);
+    d->stringValue = readString(reader, size);
     break;
 
   case BytesType:
   case GuidType:
-    d->byteVectorValue = f.readBlock(size);
+    d->byteVectorValue = reader.readBlock(size);
     break;
   }
 
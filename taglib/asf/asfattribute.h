@@ -34,6 +34,11 @@
 namespace TagLib
 {
 
+  namespace Utils
+  {
+    class ByteReader;
+  }
+
   namespace ASF
   {
 
@@ -188,6 +193,7 @@ namespace TagLib
 #ifndef DO_NOT_DOCUMENT
       /* THIS IS PRIVATE, DON'T TOUCH IT! */
       String parse(ASF::File &file, int kind = 0);
+      String parse(Utils::ByteReader &reader, int kind = 0);
 #endif
 
       //! Returns the size of the stored data
@@ -23,9 +23,11 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#include <tbytereader.h>
 #include <tdebug.h>
 #include <tbytevectorlist.h>
 #include <tpropertymap.h>
+#include <tpropertyhandlers.h>
 #include <tstring.h>
 
 #include "asffile.h"
@@ -256,19 +258,24 @@ ByteVector ASF::File::FilePrivate::ContentDescriptionObject::guid() const
   return contentDescriptionGuid;
 }
 
-void ASF::File::FilePrivate::ContentDescriptionObject::parse(ASF::File *file, unsigned int /*size*/)
+void ASF::File::FilePrivate::ContentDescriptionObject::parse(ASF::File *file, unsigned int size)
 {
   file->d->contentDescriptionObject = this;
-  const int titleLength     = readWORD(file);
-  const int artistLength    = readWORD(file);
-  const int copyrightLength = readWORD(file);
-  const int commentLength   = readWORD(file);
-  const int ratingLength    = readWORD(file);
-  file->d->tag->setTitle(readString(file,titleLength));
-  file->d->tag->setArtist(readString(file,artistLength));
-  file->d->tag->setCopyright(readString(file,copyrightLength));
-  file->d->tag->setComment(readString(file,commentLength));
-  file->d->tag->setRating(readString(file,ratingLength));
+  BaseObject::parse(file, size);
+
+  Utils::ByteReader reader(data);
+  const int titleLength     = reader.readUShort(false);
+  const int artistLength    = reader.readUShort(false);
+  const int copyrightLength = reader.readUShort(false);
+  const int commentLength   = reader.readUShort(false);
+  const int ratingLength    = reader.readUShort(false);
+  file->d->tag->setTitle(readString(reader, titleLength));
+  file->d->tag->setArtist(readString(reader, artistLength));
+  file->d->tag->setCopyright(readString(reader, copyrightLength));
+  file->d->tag->setComment(readString(reader, commentLength));
+  file->d->tag->setRating(readString(reader, ratingLength));
+
+  data.clear();
 }
 
 ByteVector ASF::File::FilePrivate::ContentDescriptionObject::render(ASF::File *file)
@@ -297,15 +304,22 @@ ByteVector ASF::File::FilePrivate::ExtendedContentDescriptionObject::guid() cons
   return extendedContentDescriptionGuid;
 }
 
-void ASF::File::FilePrivate::ExtendedContentDescriptionObject::parse(ASF::File *file, unsigned int /*size*/)
+void ASF::File::FilePrivate::ExtendedContentDescriptionObject::parse(ASF::File *file, unsigned int size)
 {
   file->d->extendedContentDescriptionObject = this;
-  int count = readWORD(file);
+  BaseObject::parse(file, size);
+
+  Utils::ByteReader reader(data);
+  int count = reader.readUShort(false);
   while(count--) {
     ASF::Attribute attribute;
-    String name = attribute.parse(*file);
+    String name = attribute.parse(reader);
+    if(!reader.isValid())
+      break;
     file->d->tag->addAttribute(name, attribute);
   }
+
+  data.clear();
 }
 
 ByteVector ASF::File::FilePrivate::ExtendedContentDescriptionObject::render(ASF::File *file)
@@ -321,15 +335,22 @@ ByteVector ASF::File::FilePrivate::MetadataObject::guid() const
   return metadataGuid;
 }
 
-void ASF::File::FilePrivate::MetadataObject::parse(ASF::File *file, unsigned int /*size*/)
+void ASF::File::FilePrivate::MetadataObject::parse(ASF::File *file, unsigned int size)
 {
   file->d->metadataObject = this;
-  int count = readWORD(file);
+  BaseObject::parse(file, size);
+
+  Utils::ByteReader reader(data);
+  int count = reader.readUShort(false);
   while(count--) {
     ASF::Attribute attribute;
-    String name = attribute.parse(*file, 1);
+    String name = attribute.parse(reader, 1);
+    if(!reader.isValid())
+      break;
     file->d->tag->addAttribute(name, attribute);
   }
+
+  data.clear();
 }
 
 ByteVector ASF::File::FilePrivate::MetadataObject::render(ASF::File *file)
@@ -345,15 +366,22 @@ ByteVector ASF::File::FilePrivate::MetadataLibraryObject::guid() const
   return metadataLibraryGuid;
 }
 
-void ASF::File::FilePrivate::MetadataLibraryObject::parse(ASF::File *file, unsigned int /*size*/)
+void ASF::File::FilePrivate::MetadataLibraryObject::parse(ASF::File *file, unsigned int size)
 {
   file->d->metadataLibraryObject = this;
-  int count = readWORD(file);
+  BaseObject::parse(file, size);
+
+  Utils::ByteReader reader(data);
+  int count = reader.readUShort(false);
   while(count--) {
     ASF::Attribute attribute;
-    String name = attribute.parse(*file, 2);
+    String name = attribute.parse(reader, 2);
+    if(!reader.isValid())
+      break;
     file->d->tag->addAttribute(name, attribute);
   }
+
+  data.clear();
 }
 
 ByteVector ASF::File::FilePrivate::MetadataLibraryObject::render(ASF::File *file)
@@ -431,41 +459,34 @@ void ASF::File::FilePrivate::CodecListObject::parse(ASF::File *file, unsigned in
     return;
   }
 
-  unsigned int pos = 16;
+  Utils::ByteReader reader(data);
+  reader.skip(16);
 
-  const int count = data.toUInt(pos, false);
-  pos += 4;
+  const int count = reader.readUInt(false);
 
   for(int i = 0; i < count; ++i) {
 
-    if(pos >= data.size())
+    if(reader.atEnd() || !reader.isValid())
       break;
 
-    const CodecType type = static_cast<CodecType>(data.toUShort(pos, false));
-    pos += 2;
-
-    int nameLength = data.toUShort(pos, false);
-    pos += 2;
-
-    const unsigned int namePos = pos;
-    pos += nameLength * 2;
+    const CodecType type = static_cast<CodecType>(reader.readUShort(false));
 
-    const int descLength = data.toUShort(pos, false);
-    pos += 2;
+    const int nameLength = reader.readUShort(false);
+    const ByteVector nameData = reader.readBlock(nameLength * 2);
 
-    const unsigned int descPos = pos;
-    pos += descLength * 2;
+    const int descLength = reader.readUShort(false);
+    const ByteVector descData = reader.readBlock(descLength * 2);
 
-    const int infoLength = data.toUShort(pos, false);
-    pos += 2 + infoLength * 2;
+    const int infoLength = reader.readUShort(false);
+    reader.skip(infoLength * 2);
 
     if(type == CodecListObject::Audio) {
       // First audio codec found.
 
-      const String name(data.mid(namePos, nameLength * 2), String::UTF16LE);
+      const String name(nameData, String::UTF16LE);
       file->d->properties->setCodecName(name.stripWhiteSpace());
 
-      const String desc(data.mid(descPos, descLength * 2), String::UTF16LE);
+      const String desc(descData, String::UTF16LE);
       file->d->properties->setCodecDescription(desc.stripWhiteSpace());
 
       break;
@@ -481,6 +502,8 @@ ASF::File::File(FileName file, bool, Properties::ReadStyle) :
   TagLib::File(file),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read();
 }
@@ -489,6 +512,8 @@ ASF::File::File(IOStream *stream, bool, Properties::ReadStyle) :
   TagLib::File(stream),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read();
 }
@@ -530,6 +555,8 @@ bool ASF::File::save()
     return false;
   }
 
+  SaveScope scope(this);
+
   if(!isValid()) {
     debug("ASF::File::save() -- Trying to save invalid file.");
     return false;
@@ -30,6 +30,8 @@
 
 #ifndef DO_NOT_DOCUMENT  // tell Doxygen not to document this header
 
+#include <tbytereader.h>
+
 namespace TagLib
 {
   namespace ASF
@@ -70,9 +72,8 @@ namespace TagLib
         return v.toLongLong(false);
       }
 
-      inline String readString(File *file, int length)
+      inline String parseString(const ByteVector &data)
       {
-        ByteVector data = file->readBlock(length);
         unsigned int size = data.size();
         while (size >= 2) {
           if(data[size - 1] != '\0' || data[size - 2] != '\0') {
@@ -81,11 +82,21 @@ namespace TagLib
           size -= 2;
         }
         if(size != data.size()) {
-          data.resize(size);
+          return String(data.mid(0, size), String::UTF16LE);
         }
         return String(data, String::UTF16LE);
       }
 
+      inline String readString(File *file, int length)
+      {
+        return parseString(file->readBlock(length));
+      }
+
+      inline String readString(Utils::ByteReader &reader, int length)
+      {
+        return parseString(reader.readBlock(length));
+      }
+
       inline ByteVector renderString(const String &str, bool includeLength = false)
       {
         ByteVector data = str.data(String::UTF16LE) + ByteVector::fromShort(0, false);
@@ -31,6 +31,8 @@
 #include <tstring.h>
 #include <tdebug.h>
 #include <trefcounter.h>
+#include <tfilestream.h>
+#include <tmemorymappedstream.h>
 
 #include "fileref.h"
 #include "asffile.h"
@@ -51,6 +53,7 @@
 #include "s3mfile.h"
 #include "itfile.h"
 #include "xmfile.h"
+#include "id3v2header.h"
 
 using namespace TagLib;
 
@@ -59,22 +62,7 @@ namespace
   typedef List<const FileRef::FileTypeResolver *> ResolverList;
   ResolverList fileTypeResolvers;
 
-  // Templatized internal functions. T should be String or IOStream*.
-
-  template <typename T>
-  FileName toFileName(T arg);
-
-  template <>
-  FileName toFileName<IOStream *>(IOStream *arg)
-  {
-    return arg->name();
-  }
-
-  template <>
-  FileName toFileName<FileName>(FileName arg)
-  {
-    return arg;
-  }
+  // Templatized internal functions. T should be FileName or IOStream*.
 
   template <typename T>
   File *resolveFileType(T arg, bool readProperties,
@@ -108,92 +96,303 @@ namespace
     return 0;
   }
 
-  template <typename T>
-  File* createInternal(T arg, bool readAudioProperties,
-                       AudioProperties::ReadStyle audioPropertiesStyle)
+  // The file types that TagLib can detect.
+
+  enum FileType {
+    UnknownType,
+    MPEGType,
+    VorbisType,
+    OggFLACType,
+    FLACType,
+    MPCType,
+    WavPackType,
+    SpeexType,
+    OpusType,
+    TrueAudioType,
+    MP4Type,
+    ASFType,
+    AIFFType,
+    WAVType,
+    APEType,
+    ModType,
+    S3MType,
+    ITType,
+    XMType
+  };
+
+  // Detection by content.  A file is of the type of the first signature whose
+  // magic bytes, and second magic bytes if there are any, are found at their
+  // offsets from the start of the file, or from the end of an ID3v2 tag at
+  // the start of the file.  To support another format, add its signatures
+  // here and its constructor to createFile() below.
+
+  struct Signature
   {
-    File *file = resolveFileType(arg, readAudioProperties, audioPropertiesStyle);
-    if(file)
-      return file;
+    FileType type;
+    unsigned int offset;
+    const char *magic;
+    unsigned int length;
+    unsigned int offset2;
+    const char *magic2;
+    unsigned int length2;
+  };
+
+  const Signature signatures[] = {
+    { FLACType,      0,    "fLaC",          4,  0,  0,                0 },
+    { VorbisType,    0,    "OggS",          4,  28, "\x01vorbis",     7 },
+    { OggFLACType,   0,    "OggS",          4,  28, "\x7f" "FLAC",    5 },
+    { SpeexType,     0,    "OggS",          4,  28, "Speex   ",       8 },
+    { OpusType,      0,    "OggS",          4,  28, "OpusHead",       8 },
+    { MPCType,       0,    "MPCK",          4,  0,  0,                0 },
+    { MPCType,       0,    "MP+",           3,  0,  0,                0 },
+    { WavPackType,   0,    "wvpk",          4,  0,  0,                0 },
+    { TrueAudioType, 0,    "TTA",           3,  0,  0,                0 },
+    { APEType,       0,    "MAC ",          4,  0,  0,                0 },
+    { MP4Type,       4,    "ftyp",          4,  0,  0,                0 },
+    { ASFType,       0,    "\x30\x26\xB2\x75\x8E\x66\xCF\x11"
+                           "\xA6\xD9\x00\xAA\x00\x62\xCE\x6C", 16, 0, 0, 0 },
+    { AIFFType,      0,    "FORM",          4,  8,  "AIFF",           4 },
+    { AIFFType,      0,    "FORM",          4,  8,  "AIFC",           4 },
+    { WAVType,       0,    "RIFF",          4,  8,  "WAVE",           4 },
+    { XMType,        0,    "Extended Module: ", 17, 0, 0,             0 },
+    { ITType,        0,    "IMPM",          4,  0,  0,                0 },
+    { S3MType,       44,   "SCRM",          4,  0,  0,                0 },
+    { ModType,       1080, "M.K.",          4,  0,  0,                0 },
+    { ModType,       1080, "M!K!",          4,  0,  0,                0 },
+    { ModType,       1080, "M&K!",          4,  0,  0,                0 },
+    { ModType,       1080, "N.T.",          4,  0,  0,                0 }
+  };
+
+  // Enough to see all of the signatures above.
+
+  const unsigned int HeadSize = 1084;
+
+  bool matches(const ByteVector &head, unsigned int offset, const char *magic, unsigned int length)
+  {
+    return (length == 0 || head.containsAt(ByteVector(magic, length), offset));
+  }
 
-#ifdef _WIN32
-    const String s = toFileName(arg).toString();
-#else
-    const String s(toFileName(arg));
-#endif
+  // MPEG audio has no magic bytes, so look for a plausible frame header.
+
+  bool isMPEGFrame(const ByteVector &head)
+  {
+    if(head.size() < 3)
+      return false;
+
+    const unsigned char b1 = static_cast<unsigned char>(head[0]);
+    const unsigned char b2 = static_cast<unsigned char>(head[1]);
+    const unsigned char b3 = static_cast<unsigned char>(head[2]);
+
+    return (b1 == 0xFF && (b2 & 0xE0) == 0xE0       // Frame sync
+            && (b2 & 0x18) != 0x08                   // Reserved version
+            && (b2 & 0x06) != 0x00                   // Reserved layer
+            && (b3 & 0xF0) != 0xF0                   // Invalid bitrate
+            && (b3 & 0x0C) != 0x0C);                 // Reserved sample rate
+  }
+
+  FileType detectByContent(IOStream *stream)
+  {
+    if(!stream || !stream->isOpen())
+      return UnknownType;
+
+    stream->seek(0);
+    ByteVector head = stream->readBlock(HeadSize);
+
+    // Many formats may be preceded by an ID3v2 tag, so look behind it.  This
+    // takes a second read only if there is such a tag.
+
+    if(head.startsWith(ID3v2::Header::fileIdentifier())) {
+      const ID3v2::Header header(head);
+      stream->seek(header.completeTagSize());
+      head = stream->readBlock(HeadSize);
+    }
 
+    stream->seek(0);
+
+    for(size_t i = 0; i < sizeof(signatures) / sizeof(signatures[0]); ++i) {
+      const Signature &sig = signatures[i];
+      if(matches(head, sig.offset, sig.magic, sig.length)
+         && matches(head, sig.offset2, sig.magic2, sig.length2))
+      {
+        return sig.type;
+      }
+    }
+
+    if(isMPEGFrame(head))
+      return MPEGType;
+
+    return UnknownType;
+  }
+
+  FileType detectByExtension(const String &fileName)
+  {
     String ext;
-    const int pos = s.rfind(".");
+    const int pos = fileName.rfind(".");
     if(pos != -1)
-      ext = s.substr(pos + 1).upper();
+      ext = fileName.substr(pos + 1).upper();
 
     // If this list is updated, the method defaultFileExtensions() should also be
     // updated.  However at some point that list should be created at the same time
     // that a default file type resolver is created.
 
     if(ext.isEmpty())
-      return 0;
+      return UnknownType;
 
     if(ext == "MP3")
-      return new MPEG::File(arg, ID3v2::FrameFactory::instance(), readAudioProperties, audioPropertiesStyle);
-    if(ext == "OGG")
-      return new Ogg::Vorbis::File(arg, readAudioProperties, audioPropertiesStyle);
-    if(ext == "OGA") {
-      /* .oga can be any audio in the Ogg container. First try FLAC, then Vorbis. */
-      File *file = new Ogg::FLAC::File(arg, readAudioProperties, audioPropertiesStyle);
-      if(file->isValid())
-        return file;
-      delete file;
-      return new Ogg::Vorbis::File(arg, readAudioProperties, audioPropertiesStyle);
-    }
+      return MPEGType;
+    // .oga can be any audio in the Ogg container, and is normally told apart
+    // by content.
+    if(ext == "OGG" || ext == "OGA")
+      return VorbisType;
     if(ext == "FLAC")
-      return new FLAC::File(arg, ID3v2::FrameFactory::instance(), readAudioProperties, audioPropertiesStyle);
+      return FLACType;
     if(ext == "MPC")
-      return new MPC::File(arg, readAudioProperties, audioPropertiesStyle);
+      return MPCType;
     if(ext == "WV")
-      return new WavPack::File(arg, readAudioProperties, audioPropertiesStyle);
+      return WavPackType;
     if(ext == "SPX")
-      return new Ogg::Speex::File(arg, readAudioProperties, audioPropertiesStyle);
+      return SpeexType;
     if(ext == "OPUS")
-      return new Ogg::Opus::File(arg, readAudioProperties, audioPropertiesStyle);
+      return OpusType;
     if(ext == "TTA")
-      return new TrueAudio::File(arg, readAudioProperties, audioPropertiesStyle);
+      return TrueAudioType;
     if(ext == "M4A" || ext == "M4R" || ext == "M4B" || ext == "M4P" || ext == "MP4" || ext == "3G2" || ext == "M4V")
-      return new MP4::File(arg, readAudioProperties, audioPropertiesStyle);
+      return MP4Type;
     if(ext == "WMA" || ext == "ASF")
-      return new ASF::File(arg, readAudioProperties, audioPropertiesStyle);
+      return ASFType;
     if(ext == "AIF" || ext == "AIFF" || ext == "AFC" || ext == "AIFC")
-      return new RIFF::AIFF::File(arg, readAudioProperties, audioPropertiesStyle);
+      return AIFFType;
     if(ext == "WAV")
-      return new RIFF::WAV::File(arg, readAudioProperties, audioPropertiesStyle);
+      return WAVType;
     if(ext == "APE")
-      return new APE::File(arg, readAudioProperties, audioPropertiesStyle);
+      return APEType;
     // module, nst and wow are possible but uncommon extensions
     if(ext == "MOD" || ext == "MODULE" || ext == "NST" || ext == "WOW")
-      return new Mod::File(arg, readAudioProperties, audioPropertiesStyle);
+      return ModType;
     if(ext == "S3M")
-      return new S3M::File(arg, readAudioProperties, audioPropertiesStyle);
+      return S3MType;
     if(ext == "IT")
-      return new IT::File(arg, readAudioProperties, audioPropertiesStyle);
+      return ITType;
     if(ext == "XM")
+      return XMType;
+
+    return UnknownType;
+  }
+
+  template <typename T>
+  File *createFile(FileType type, T arg, bool readAudioProperties,
+                   AudioProperties::ReadStyle audioPropertiesStyle)
+  {
+    switch(type) {
+    case MPEGType:
+      return new MPEG::File(arg, ID3v2::FrameFactory::instance(), readAudioProperties, audioPropertiesStyle);
+    case VorbisType:
+      return new Ogg::Vorbis::File(arg, readAudioProperties, audioPropertiesStyle);
+    case OggFLACType:
+      return new Ogg::FLAC::File(arg, readAudioProperties, audioPropertiesStyle);
+    case FLACType:
+      return new FLAC::File(arg, ID3v2::FrameFactory::instance(), readAudioProperties, audioPropertiesStyle);
+    case MPCType:
+      return new MPC::File(arg, readAudioProperties, audioPropertiesStyle);
+    case WavPackType:
+      return new WavPack::File(arg, readAudioProperties, audioPropertiesStyle);
+    case SpeexType:
+      return new Ogg::Speex::File(arg, readAudioProperties, audioPropertiesStyle);
+    case OpusType:
+      return new Ogg::Opus::File(arg, readAudioProperties, audioPropertiesStyle);
+    case TrueAudioType:
+      return new TrueAudio::File(arg, readAudioProperties, audioPropertiesStyle);
+    case MP4Type:
+      return new MP4::File(arg, readAudioProperties, audioPropertiesStyle);
+    case ASFType:
+      return new ASF::File(arg, readAudioProperties, audioPropertiesStyle);
+    case AIFFType:
+      return new RIFF::AIFF::File(arg, readAudioProperties, audioPropertiesStyle);
+    case WAVType:
+      return new RIFF::WAV::File(arg, readAudioProperties, audioPropertiesStyle);
+    case APEType:
+      return new APE::File(arg, readAudioProperties, audioPropertiesStyle);
+    case ModType:
+      return new Mod::File(arg, readAudioProperties, audioPropertiesStyle);
+    case S3MType:
+      return new S3M::File(arg, readAudioProperties, audioPropertiesStyle);
+    case ITType:
+      return new IT::File(arg, readAudioProperties, audioPropertiesStyle);
+    case XMType:
       return new XM::File(arg, readAudioProperties, audioPropertiesStyle);
+    default:
+      return 0;
+    }
+  }
 
-    return 0;
+  String fileNameString(FileName fileName)
+  {
+#ifdef _WIN32
+    return fileName.toString();
+#else
+    return String(fileName);
+#endif
+  }
+
+  // The file type is detected by content first, so that misnamed files work,
+  // and by the extension if the content is not recognized.
+
+  File *createInternal(IOStream *stream, bool readAudioProperties,
+                       AudioProperties::ReadStyle audioPropertiesStyle)
+  {
+    File *file = resolveFileType(stream, readAudioProperties, audioPropertiesStyle);
+    if(file)
+      return file;
+
+    FileType type = detectByContent(stream);
+    if(type == UnknownType)
+      type = detectByExtension(fileNameString(stream->name()));
+
+    return createFile(type, stream, readAudioProperties, audioPropertiesStyle);
+  }
+
+  // If \a ownedStream is given, the file is read through a FileStream that is
+  // also used for the detection and returned there to be owned by the caller.
+
+  File *createInternal(FileName fileName, bool readAudioProperties,
+                       AudioProperties::ReadStyle audioPropertiesStyle,
+                       IOStream **ownedStream = 0)
+  {
+    File *file = resolveFileType(fileName, readAudioProperties, audioPropertiesStyle);
+    if(file)
+      return file;
+
+    FileStream *stream = new FileStream(fileName);
+
+    FileType type = detectByContent(stream);
+    if(type == UnknownType)
+      type = detectByExtension(fileNameString(fileName));
+
+    if(ownedStream && stream->isOpen() && type != UnknownType) {
+      *ownedStream = stream;
+      return createFile<IOStream *>(type, stream, readAudioProperties, audioPropertiesStyle);
+    }
+
+    delete stream;
+    return createFile(type, fileName, readAudioProperties, audioPropertiesStyle);
   }
 }
 
 class FileRef::FileRefPrivate : public RefCounter
 {
 public:
-  FileRefPrivate(File *f) :
+  FileRefPrivate(File *f, IOStream *s = 0) :
     RefCounter(),
-    file(f) {}
+    file(f),
+    stream(s) {}
 
   ~FileRefPrivate() {
     delete file;
+    delete stream;
   }
 
   File *file;
+  IOStream *stream;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -207,8 +406,26 @@ FileRef::FileRef() :
 
 FileRef::FileRef(FileName fileName, bool readAudioProperties,
                  AudioProperties::ReadStyle audioPropertiesStyle) :
-  d(new FileRefPrivate(createInternal(fileName, readAudioProperties, audioPropertiesStyle)))
+  d(new FileRefPrivate(0))
 {
+  d->file = createInternal(fileName, readAudioProperties, audioPropertiesStyle, &d->stream);
+}
+
+FileRef::FileRef(FileName fileName, bool readAudioProperties,
+                 AudioProperties::ReadStyle audioPropertiesStyle, bool memoryMapped) :
+  d(0)
+{
+  if(memoryMapped) {
+    MemoryMappedStream *stream = new MemoryMappedStream(fileName);
+    if(stream->isOpen()) {
+      d = new FileRefPrivate(createInternal(stream, readAudioProperties, audioPropertiesStyle), stream);
+      return;
+    }
+    delete stream;
+  }
+
+  d = new FileRefPrivate(0);
+  d->file = createInternal(fileName, readAudioProperties, audioPropertiesStyle, &d->stream);
 }
 
 FileRef::FileRef(IOStream* stream, bool readAudioProperties, AudioProperties::ReadStyle audioPropertiesStyle) :
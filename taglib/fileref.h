@@ -63,8 +63,9 @@ namespace TagLib {
   //! A class for pluggable file type resolution.
 
   /*!
-   * This class is used to add extend TagLib's very basic file name based file
-   * type resolution.
+   * This class is used to add extend TagLib's built-in file type resolution,
+   * which looks at the first bytes of the file and falls back to the file
+   * name extension.
    *
    * This can be accomplished with:
    *
@@ -133,6 +134,22 @@ namespace TagLib {
                      AudioProperties::ReadStyle
                      audioPropertiesStyle = AudioProperties::Average);
 
+    /*!
+     * Create a FileRef from \a fileName in the same way as the constructor above.
+     * If \a memoryMapped is true, the file is read through a read-only
+     * MemoryMappedStream instead of a FileStream, which avoids a system call
+     * for each read.  This is useful for applications that only scan tags.
+     * If the file can't be mapped, it is opened normally.
+     *
+     * \note A file opened through a MemoryMappedStream can not be saved.
+     *
+     * \see MemoryMappedStream
+     */
+    FileRef(FileName fileName,
+            bool readAudioProperties,
+            AudioProperties::ReadStyle audioPropertiesStyle,
+            bool memoryMapped);
+
     /*!
      * Construct a FileRef from an opened \a IOStream.  If \a readAudioProperties
      * is true then the audio properties will be read using \a audioPropertiesStyle.
@@ -222,9 +239,8 @@ namespace TagLib {
     static const FileTypeResolver *addFileTypeResolver(const FileTypeResolver *resolver);
 
     /*!
-     * As is mentioned elsewhere in this class's documentation, the default file
-     * type resolution code provided by TagLib only works by comparing file
-     * extensions.
+     * The default file type resolution code provided by TagLib identifies a
+     * file by its content and, if that fails, by comparing file extensions.
      *
      * This method returns the list of file extensions that are used by default.
      *
@@ -24,11 +24,13 @@
  ***************************************************************************/
 
 #include <tbytevector.h>
+#include <tbytereader.h>
 #include <tstring.h>
 #include <tlist.h>
 #include <tdebug.h>
 #include <tagunion.h>
 #include <tpropertymap.h>
+#include <tpropertyhandlers.h>
 #include <tagutils.h>
 
 #include <id3v2header.h>
@@ -106,6 +108,8 @@ FLAC::File::File(FileName file, bool readProperties, Properties::ReadStyle) :
   TagLib::File(file),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -115,6 +119,8 @@ FLAC::File::File(FileName file, ID3v2::FrameFactory *frameFactory,
   TagLib::File(file),
   d(new FilePrivate(frameFactory))
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -124,6 +130,8 @@ FLAC::File::File(IOStream *stream, ID3v2::FrameFactory *frameFactory,
   TagLib::File(stream),
   d(new FilePrivate(frameFactory))
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -165,6 +173,8 @@ bool FLAC::File::save()
     return false;
   }
 
+  SaveScope scope(this);
+
   if(!isValid()) {
     debug("FLAC::File::save() -- Trying to save invalid file.");
     return false;
@@ -205,14 +215,25 @@ bool FLAC::File::save()
   long originalLength = d->streamStart - d->flacStart;
   long paddingLength = originalLength - data.size() - 4;
 
+  // If the file can grow by whole blocks without rewriting the rest of it,
+  // the padding is rounded up to make the metadata grow that way.
+
+  const long alignment = resizeAlignment();
+
   if(paddingLength <= 0) {
     paddingLength = MinPaddingLength;
+
+    if(alignment > 0) {
+      const long growth = static_cast<long>(data.size()) + 4 + MinPaddingLength - originalLength;
+      paddingLength += (alignment - growth % alignment) % alignment;
+    }
   }
   else {
-    // Padding won't increase beyond 1% of the file size or 1MB.
+    // Padding won't increase beyond 1% of the file size or 1MB, but it may
+    // keep the extra space added when the file grew by whole blocks.
 
     long threshold = length() / 100;
-    threshold = std::max(threshold, MinPaddingLength);
+    threshold = std::max(threshold, MinPaddingLength + alignment);
     threshold = std::min(threshold, MaxPaddingLegnth);
 
     if(paddingLength > threshold)
@@ -300,7 +321,12 @@ bool FLAC::File::save()
 
 ID3v2::Tag *FLAC::File::ID3v2Tag(bool create)
 {
-  return d->tag.access<ID3v2::Tag>(FlacID3v2Index, create);
+  // A new tag is bound to this file, so that its padding fits the file.
+
+  if(create && !d->tag[FlacID3v2Index])
+    d->tag.set(FlacID3v2Index, new ID3v2::Tag(this, -1, d->ID3v2FrameFactory));
+
+  return d->tag.access<ID3v2::Tag>(FlacID3v2Index, false);
 }
 
 ID3v1::Tag *FLAC::File::ID3v1Tag(bool create)
@@ -405,19 +431,15 @@ bool FLAC::File::hasID3v2Tag() const
 
 void FLAC::File::read(bool readProperties)
 {
-  // Look for an ID3v2 tag
+  // Look for ID3v2 and ID3v1 tags
 
-  d->ID3v2Location = Utils::findID3v2(this);
+  Utils::findTags(this, &d->ID3v2Location, &d->ID3v1Location, 0);
 
   if(d->ID3v2Location >= 0) {
     d->tag.set(FlacID3v2Index, new ID3v2::Tag(this, d->ID3v2Location, d->ID3v2FrameFactory));
     d->ID3v2OriginalSize = ID3v2Tag()->header()->completeTagSize();
   }
 
-  // Look for an ID3v1 tag
-
-  d->ID3v1Location = Utils::findID3v1(this);
-
   if(d->ID3v1Location >= 0)
     d->tag.set(FlacID3v1Index, new ID3v1::Tag(this, d->ID3v1Location));
 
@@ -493,9 +515,11 @@ void FLAC::File::scan()
     //    ..
     // <24> Length of metadata to follow
 
-    const char blockType = header[0] & ~LastBlockFlag;
-    const bool isLastBlock = (header[0] & LastBlockFlag) != 0;
-    const unsigned int blockLength = header.toUInt(1U, 3U);
+    Utils::ByteReader reader(header);
+    const unsigned char flags = reader.readByte();
+    const char blockType = flags & ~LastBlockFlag;
+    const bool isLastBlock = (flags & LastBlockFlag) != 0;
+    const unsigned int blockLength = reader.readUInt24();
 
     // First block should be the stream_info metadata
 
@@ -24,6 +24,7 @@
  ***************************************************************************/
 
 #include <taglib.h>
+#include <tbytereader.h>
 #include <tdebug.h>
 #include "flacpicture.h"
 
@@ -78,40 +79,30 @@ bool FLAC::Picture::parse(const ByteVector &data)
     return false;
   }
 
-  unsigned int pos = 0;
-  d->type = FLAC::Picture::Type(data.toUInt(pos));
-  pos += 4;
-  unsigned int mimeTypeLength = data.toUInt(pos);
-  pos += 4;
-  if(pos + mimeTypeLength + 24 > data.size()) {
+  Utils::ByteReader reader(data);
+  d->type = FLAC::Picture::Type(reader.readUInt());
+  const unsigned int mimeTypeLength = reader.readUInt();
+  if(mimeTypeLength > reader.remaining() || reader.remaining() - mimeTypeLength < 24) {
     debug("Invalid picture block.");
     return false;
   }
-  d->mimeType = String(data.mid(pos, mimeTypeLength), String::UTF8);
-  pos += mimeTypeLength;
-  unsigned int descriptionLength = data.toUInt(pos);
-  pos += 4;
-  if(pos + descriptionLength + 20 > data.size()) {
+  d->mimeType = String(reader.readBlock(mimeTypeLength), String::UTF8);
+  const unsigned int descriptionLength = reader.readUInt();
+  if(descriptionLength > reader.remaining() || reader.remaining() - descriptionLength < 20) {
     debug("Invalid picture block.");
     return false;
   }
-  d->description = String(data.mid(pos, descriptionLength), String::UTF8);
-  pos += descriptionLength;
-  d->width = data.toUInt(pos);
-  pos += 4;
-  d->height = data.toUInt(pos);
-  pos += 4;
-  d->colorDepth = data.toUInt(pos);
-  pos += 4;
-  d->numColors = data.toUInt(pos);
-  pos += 4;
-  unsigned int dataLength = data.toUInt(pos);
-  pos += 4;
-  if(pos + dataLength > data.size()) {
+  d->description = String(reader.readBlock(descriptionLength), String::UTF8);
+  d->width = reader.readUInt();
+  d->height = reader.readUInt();
+  d->colorDepth = reader.readUInt();
+  d->numColors = reader.readUInt();
+  const unsigned int dataLength = reader.readUInt();
+  if(dataLength > reader.remaining()) {
     debug("Invalid picture block.");
     return false;
   }
-  d->data = data.mid(pos, dataLength);
+  d->data = reader.readBlock(dataLength);
 
   return true;
 }
@@ -24,6 +24,7 @@
  ***************************************************************************/
 
 #include <tstring.h>
+#include <tbytereader.h>
 #include <tdebug.h>
 
 #include "flacproperties.h"
@@ -135,22 +136,21 @@ void FLAC::Properties::read(const ByteVector &data, long streamLength)
     return;
   }
 
-  unsigned int pos = 0;
+  Utils::ByteReader reader(data);
 
   // Minimum block size (in samples)
-  pos += 2;
+  reader.skip(2);
 
   // Maximum block size (in samples)
-  pos += 2;
+  reader.skip(2);
 
   // Minimum frame size (in bytes)
-  pos += 3;
+  reader.skip(3);
 
   // Maximum frame size (in bytes)
-  pos += 3;
+  reader.skip(3);
 
-  const unsigned int flags = data.toUInt(pos, true);
-  pos += 4;
+  const unsigned int flags = reader.readUInt();
 
   d->sampleRate    = flags >> 12;
   d->channels      = ((flags >> 9) &  7) + 1;
@@ -160,8 +160,7 @@ void FLAC::Properties::read(const ByteVector &data, long streamLength)
   // stream length in samples. (Audio files measured in days)
 
   const unsigned long long hi = flags & 0xf;
-  const unsigned long long lo = data.toUInt(pos, true);
-  pos += 4;
+  const unsigned long long lo = reader.readUInt();
 
   d->sampleFrames = (hi << 32) | lo;
 
@@ -171,6 +170,6 @@ void FLAC::Properties::read(const ByteVector &data, long streamLength)
     d->bitrate = static_cast<int>(streamLength * 8.0 / length + 0.5);
   }
 
-  if(data.size() >= pos + 16)
-    d->signature = data.mid(pos, 16);
+  if(reader.remaining() >= 16)
+    d->signature = reader.readBlock(16);
 }
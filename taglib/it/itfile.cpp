@@ -29,6 +29,7 @@
 #include "tdebug.h"
 #include "modfileprivate.h"
 #include "tpropertymap.h"
+#include "tpropertyhandlers.h"
 
 using namespace TagLib;
 using namespace IT;
@@ -50,6 +51,8 @@ IT::File::File(FileName file, bool readProperties,
   Mod::FileBase(file),
   d(new FilePrivate(propertiesStyle))
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -59,6 +62,8 @@ IT::File::File(IOStream *stream, bool readProperties,
   Mod::FileBase(stream),
   d(new FilePrivate(propertiesStyle))
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -95,6 +100,9 @@ bool IT::File::save()
     debug("IT::File::save() - Cannot save to a read only file.");
     return false;
   }
+
+  SaveScope scope(this);
+
   seek(4);
   writeString(d->tag.title(), 25);
   writeByte(0);
@@ -29,6 +29,7 @@
 #include "tdebug.h"
 #include "modfileprivate.h"
 #include "tpropertymap.h"
+#include "tpropertyhandlers.h"
 
 using namespace TagLib;
 using namespace Mod;
@@ -50,6 +51,8 @@ Mod::File::File(FileName file, bool readProperties,
   Mod::FileBase(file),
   d(new FilePrivate(propertiesStyle))
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -59,6 +62,8 @@ Mod::File::File(IOStream *stream, bool readProperties,
   Mod::FileBase(stream),
   d(new FilePrivate(propertiesStyle))
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -94,6 +99,9 @@ bool Mod::File::save()
     debug("Mod::File::save() - Cannot save to a read only file.");
     return false;
   }
+
+  SaveScope scope(this);
+
   seek(0);
   writeString(d->tag.title(), 20);
   StringList lines = d->tag.comment().split("\n");
@@ -25,8 +25,10 @@
 
 #include <climits>
 
+#include <tbytereader.h>
 #include <tdebug.h>
 #include <tstring.h>
+#include <tarena.h>
 #include "mp4atom.h"
 
 using namespace TagLib;
@@ -37,10 +39,17 @@ const char *MP4::Atom::containers[11] = {
     "stsd"
 };
 
-MP4::Atom::Atom(File *file)
+// The atoms of a file are allocated in an arena, since a file can have many
+// of them, e.g. in the fragments of a stream, and they are all freed at once.
+
+class MP4::Atoms::AtomsPrivate
 {
-  children.setAutoDelete(true);
+public:
+  Utils::Arena arena;
+};
 
+MP4::Atom::Atom(File *file, Atoms *atoms)
+{
   offset = file->tell();
   ByteVector header = file->readBlock(8);
   if(header.size() != 8) {
@@ -52,7 +61,8 @@ MP4::Atom::Atom(File *file)
     return;
   }
 
-  length = header.toUInt();
+  Utils::ByteReader reader(header);
+  length = reader.readUInt();
 
   if(length == 0) {
     // The last atom which extends to the end of the file.
@@ -80,7 +90,7 @@ MP4::Atom::Atom(File *file)
     return;
   }
 
-  name = header.mid(4, 4);
+  name = reader.readBlock(4);
 
   for(int i = 0; i < numContainers; i++) {
     if(name == containers[i]) {
@@ -91,9 +101,8 @@ MP4::Atom::Atom(File *file)
         file->seek(8, File::Current);
       }
       while(file->tell() < offset + length) {
-        MP4::Atom *child = new MP4::Atom(file);
+        MP4::Atom *child = atoms->read(file);
         if (child->length == 0) {
-          delete child;
           return;
         }
         children.append(child);
@@ -153,17 +162,15 @@ MP4::Atom::path(MP4::AtomList &path, const char *name1, const char *name2, const
   return false;
 }
 
-MP4::Atoms::Atoms(File *file)
+MP4::Atoms::Atoms(File *file) :
+  d(new AtomsPrivate())
 {
-  atoms.setAutoDelete(true);
-
   file->seek(0, File::End);
   long end = file->tell();
   file->seek(0);
   while(file->tell() + 8 <= end) {
-    MP4::Atom *atom = new MP4::Atom(file);
+    MP4::Atom *atom = read(file);
     if (atom->length == 0) {
-      delete atom;
       break;
     }
     atoms.append(atom);
@@ -172,6 +179,7 @@ MP4::Atoms::Atoms(File *file)
 
 MP4::Atoms::~Atoms()
 {
+  delete d;
 }
 
 MP4::Atom *
@@ -199,3 +207,9 @@ MP4::Atoms::path(const char *name1, const char *name2, const char *name3, const
   }
   return path;
 }
+
+MP4::Atom *
+MP4::Atoms::read(File *file)
+{
+  return d->arena.create<Atom>(file, this);
+}
@@ -38,6 +38,7 @@ namespace TagLib {
   namespace MP4 {
 
     class Atom;
+    class Atoms;
     typedef TagLib::List<Atom *> AtomList;
 
     enum AtomDataType
@@ -77,7 +78,7 @@ namespace TagLib {
     class Atom
     {
     public:
-      Atom(File *file);
+      Atom(File *file, Atoms *atoms);
       ~Atom();
       Atom *find(const char *name1, const char *name2 = 0, const char *name3 = 0, const char *name4 = 0);
       bool path(AtomList &path, const char *name1, const char *name2 = 0, const char *name3 = 0);
@@ -87,6 +88,9 @@ namespace TagLib {
       TagLib::ByteVector name;
       AtomList children;
     private:
+      Atom(const Atom &);
+      Atom &operator=(const Atom &);
+
       static const int numContainers = 11;
       static const char *containers[11];
     };
@@ -99,7 +103,21 @@ namespace TagLib {
       ~Atoms();
       Atom *find(const char *name1, const char *name2 = 0, const char *name3 = 0, const char *name4 = 0);
       AtomList path(const char *name1, const char *name2 = 0, const char *name3 = 0, const char *name4 = 0);
+
+      /*!
+       * Reads the atom at the current position of \a file and its children.
+       * The atoms are owned by this object and freed all at once with it.
+       */
+      Atom *read(File *file);
+
       AtomList atoms;
+
+    private:
+      Atoms(const Atoms &);
+      Atoms &operator=(const Atoms &);
+
+      class AtomsPrivate;
+      AtomsPrivate *d;
     };
 
   }
@@ -26,6 +26,7 @@
 #include <tdebug.h>
 #include <tstring.h>
 #include <tpropertymap.h>
+#include <tpropertyhandlers.h>
 #include "mp4atom.h"
 #include "mp4tag.h"
 #include "mp4file.h"
@@ -73,6 +74,8 @@ MP4::File::File(FileName file, bool readProperties, AudioProperties::ReadStyle)
   TagLib::File(file),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -81,6 +84,8 @@ MP4::File::File(IOStream *stream, bool readProperties, AudioProperties::ReadStyl
   TagLib::File(stream),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -154,6 +159,8 @@ MP4::File::save()
     return false;
   }
 
+  SaveScope scope(this);
+
   return d->tag->save();
 }
 
@@ -23,6 +23,7 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#include <tbytereader.h>
 #include <tdebug.h>
 #include <tstring.h>
 #include <tpropertymap.h>
@@ -108,18 +109,19 @@ MP4::AtomDataList
 MP4::Tag::parseData2(const MP4::Atom *atom, int expectedFlags, bool freeForm)
 {
   AtomDataList result;
-  ByteVector data = d->file->readBlock(atom->length - 8);
+  const ByteVector data = d->file->readBlock(atom->length - 8);
+  Utils::ByteReader reader(data);
   int i = 0;
-  unsigned int pos = 0;
-  while(pos < data.size()) {
-    const int length = static_cast<int>(data.toUInt(pos));
+  while(!reader.atEnd()) {
+    const size_t pos = reader.position();
+    const int length = static_cast<int>(reader.readUInt());
     if(length < 12) {
       debug("MP4: Too short atom");
       return result;
     }
 
-    const ByteVector name = data.mid(pos + 4, 4);
-    const int flags = static_cast<int>(data.toUInt(pos + 8));
+    const ByteVector name = reader.readBlock(4);
+    const int flags = static_cast<int>(reader.readUInt());
     if(freeForm && i < 2) {
       if(i == 0 && name != "mean") {
         debug("MP4: Unexpected atom \"" + name + "\", expecting \"mean\"");
@@ -140,7 +142,8 @@ MP4::Tag::parseData2(const MP4::Atom *atom, int expectedFlags, bool freeForm)
         result.append(AtomData(AtomDataType(flags), data.mid(pos + 16, length - 16)));
       }
     }
-    pos += length;
+    if(!reader.seek(pos + length))
+      break;
     i++;
   }
   return result;
@@ -325,7 +328,10 @@ MP4::Tag::padIlst(const ByteVector &data, int length) const
 ByteVector
 MP4::Tag::renderAtom(const ByteVector &name, const ByteVector &data) const
 {
-  return ByteVector::fromUInt(data.size() + 8) + name + data;
+  ByteVector atom = ByteVector::fromUInt(data.size() + 8);
+  atom.append(name);
+  atom.append(data);
+  return atom;
 }
 
 ByteVector
@@ -333,7 +339,10 @@ MP4::Tag::renderData(const ByteVector &name, int flags, const ByteVectorList &da
 {
   ByteVector result;
   for(ByteVectorList::ConstIterator it = data.begin(); it != data.end(); ++it) {
-    result.append(renderAtom("data", ByteVector::fromUInt(flags) + ByteVector(4, '\0') + *it));
+    ByteVector atomData = ByteVector::fromUInt(flags);
+    atomData.resize(8, '\0');
+    atomData.append(*it);
+    result.append(renderAtom("data", atomData));
   }
   return renderAtom(name, result);
 }
@@ -634,7 +643,7 @@ MP4::Tag::saveNew(ByteVector data)
   // Insert the newly created atoms into the tree to keep it up-to-date.
 
   d->file->seek(offset);
-  path.back()->children.prepend(new Atom(d->file));
+  path.back()->children.prepend(d->atoms->read(d->file));
 }
 
 void
@@ -28,6 +28,7 @@
 #include <tagunion.h>
 #include <tdebug.h>
 #include <tpropertymap.h>
+#include <tpropertyhandlers.h>
 #include <tagutils.h>
 
 #include "mpcfile.h"
@@ -83,6 +84,8 @@ MPC::File::File(FileName file, bool readProperties, Properties::ReadStyle) :
   TagLib::File(file),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -91,6 +94,8 @@ MPC::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle) :
   TagLib::File(stream),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -135,6 +140,8 @@ bool MPC::File::save()
     return false;
   }
 
+  SaveScope scope(this);
+
   // Possibly strip ID3v2 tag
 
   if(!d->ID3v2Header && d->ID3v2Location >= 0) {
@@ -263,9 +270,9 @@ bool MPC::File::hasAPETag() const
 
 void MPC::File::read(bool readProperties)
 {
-  // Look for an ID3v2 tag
+  // Look for ID3v2, ID3v1 and APE tags
 
-  d->ID3v2Location = Utils::findID3v2(this);
+  Utils::findTags(this, &d->ID3v2Location, &d->ID3v1Location, &d->APELocation);
 
   if(d->ID3v2Location >= 0) {
     seek(d->ID3v2Location);
@@ -273,17 +280,9 @@ void MPC::File::read(bool readProperties)
     d->ID3v2Size = d->ID3v2Header->completeTagSize();
   }
 
-  // Look for an ID3v1 tag
-
-  d->ID3v1Location = Utils::findID3v1(this);
-
   if(d->ID3v1Location >= 0)
     d->tag.set(MPCID3v1Index, new ID3v1::Tag(this, d->ID3v1Location));
 
-  // Look for an APE tag
-
-  d->APELocation = Utils::findAPE(this, d->ID3v1Location);
-
   if(d->APELocation >= 0) {
     d->tag.set(MPCAPEIndex, new APE::Tag(this, d->APELocation));
     d->APESize = APETag()->footer()->completeTagSize();
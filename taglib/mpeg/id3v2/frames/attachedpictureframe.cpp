@@ -68,57 +68,68 @@ AttachedPictureFrame::~AttachedPictureFrame()
 
 String AttachedPictureFrame::toString() const
 {
+  parsePendingFields();
   String s = "[" + d->mimeType + "]";
   return d->description.isEmpty() ? s : d->description + " " + s;
 }
 
 String::Type AttachedPictureFrame::textEncoding() const
 {
+  parsePendingFields();
   return d->textEncoding;
 }
 
 void AttachedPictureFrame::setTextEncoding(String::Type t)
 {
+  parsePendingFields();
   d->textEncoding = t;
 }
 
 String AttachedPictureFrame::mimeType() const
 {
+  parsePendingFields();
   return d->mimeType;
 }
 
 void AttachedPictureFrame::setMimeType(const String &m)
 {
+  parsePendingFields();
   d->mimeType = m;
 }
 
 AttachedPictureFrame::Type AttachedPictureFrame::type() const
 {
+  parsePendingFields();
   return d->type;
 }
 
 void AttachedPictureFrame::setType(Type t)
 {
+  parsePendingFields();
   d->type = t;
 }
 
 String AttachedPictureFrame::description() const
 {
+  parsePendingFields();
   return d->description;
 }
 
 void AttachedPictureFrame::setDescription(const String &desc)
 {
+  parsePendingFields();
   d->description = desc;
 }
 
 ByteVector AttachedPictureFrame::picture() const
 {
+  parsePendingFields();
   return d->data;
 }
 
 void AttachedPictureFrame::setPicture(const ByteVector &p)
 {
+  parsePendingFields();
   d->data = p;
 }
 
@@ -152,6 +163,7 @@ void AttachedPictureFrame::parseFields(const ByteVector &data)
 
 ByteVector AttachedPictureFrame::renderFields() const
 {
+  parsePendingFields();
   ByteVector data;
 
   String::Type encoding = checkTextEncoding(d->description, d->textEncoding);
@@ -171,11 +183,14 @@ ByteVector AttachedPictureFrame::renderFields() const
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
-AttachedPictureFrame::AttachedPictureFrame(const ByteVector &data, Header *h) :
+AttachedPictureFrame::AttachedPictureFrame(const ByteVector &data, Header *h, bool lazy) :
   Frame(h),
   d(new AttachedPictureFramePrivate())
 {
-  parseFields(fieldData(data));
+  if(lazy)
+    setPendingFields(fieldData(data));
+  else
+    parseFields(fieldData(data));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -211,7 +211,7 @@ namespace TagLib {
     private:
       AttachedPictureFrame(const AttachedPictureFrame &);
       AttachedPictureFrame &operator=(const AttachedPictureFrame &);
-      AttachedPictureFrame(const ByteVector &data, Header *h);
+      AttachedPictureFrame(const ByteVector &data, Header *h, bool lazy);
 
     };
 
@@ -97,31 +97,37 @@ ChapterFrame::~ChapterFrame()
 
 ByteVector ChapterFrame::elementID() const
 {
+  parsePendingFields();
   return d->elementID;
 }
 
 unsigned int ChapterFrame::startTime() const
 {
+  parsePendingFields();
   return d->startTime;
 }
 
 unsigned int ChapterFrame::endTime() const
 {
+  parsePendingFields();
   return d->endTime;
 }
 
 unsigned int ChapterFrame::startOffset() const
 {
+  parsePendingFields();
   return d->startOffset;
 }
 
 unsigned int ChapterFrame::endOffset() const
 {
+  parsePendingFields();
   return d->endOffset;
 }
 
 void ChapterFrame::setElementID(const ByteVector &eID)
 {
+  parsePendingFields();
   d->elementID = eID;
 
   if(d->elementID.endsWith(char(0)))
@@ -130,47 +136,56 @@ void ChapterFrame::setElementID(const ByteVector &eID)
 
 void ChapterFrame::setStartTime(const unsigned int &sT)
 {
+  parsePendingFields();
   d->startTime = sT;
 }
 
 void ChapterFrame::setEndTime(const unsigned int &eT)
 {
+  parsePendingFields();
   d->endTime = eT;
 }
 
 void ChapterFrame::setStartOffset(const unsigned int &sO)
 {
+  parsePendingFields();
   d->startOffset = sO;
 }
 
 void ChapterFrame::setEndOffset(const unsigned int &eO)
 {
+  parsePendingFields();
   d->endOffset = eO;
 }
 
 const FrameListMap &ChapterFrame::embeddedFrameListMap() const
 {
+  parsePendingFields();
   return d->embeddedFrameListMap;
 }
 
 const FrameList &ChapterFrame::embeddedFrameList() const
 {
+  parsePendingFields();
   return d->embeddedFrameList;
 }
 
 const FrameList &ChapterFrame::embeddedFrameList(const ByteVector &frameID) const
 {
+  parsePendingFields();
   return d->embeddedFrameListMap[frameID];
 }
 
 void ChapterFrame::addEmbeddedFrame(Frame *frame)
 {
+  parsePendingFields();
   d->embeddedFrameList.append(frame);
   d->embeddedFrameListMap[frame->frameID()].append(frame);
 }
 
 void ChapterFrame::removeEmbeddedFrame(Frame *frame, bool del)
 {
+  parsePendingFields();
   // remove the frame from the frame list
   FrameList::Iterator it = d->embeddedFrameList.find(frame);
   d->embeddedFrameList.erase(it);
@@ -186,6 +201,7 @@ void ChapterFrame::removeEmbeddedFrame(Frame *frame, bool del)
 
 void ChapterFrame::removeEmbeddedFrames(const ByteVector &id)
 {
+  parsePendingFields();
   FrameList l = d->embeddedFrameListMap[id];
   for(FrameList::ConstIterator it = l.begin(); it != l.end(); ++it)
     removeEmbeddedFrame(*it, true);
@@ -193,6 +209,7 @@ void ChapterFrame::removeEmbeddedFrames(const ByteVector &id)
 
 String ChapterFrame::toString() const
 {
+  parsePendingFields();
   String s = String(d->elementID) +
              ": start time: " + String::number(d->startTime) +
              ", end time: " + String::number(d->endTime);
@@ -216,6 +233,7 @@ String ChapterFrame::toString() const
 
 PropertyMap ChapterFrame::asProperties() const
 {
+  parsePendingFields();
   PropertyMap map;
 
   map.unsupportedData().append(frameID() + String("/") + d->elementID);
@@ -285,6 +303,7 @@ void ChapterFrame::parseFields(const ByteVector &data)
 
 ByteVector ChapterFrame::renderFields() const
 {
+  parsePendingFields();
   ByteVector data;
 
   data.append(d->elementID);
@@ -300,10 +319,14 @@ ByteVector ChapterFrame::renderFields() const
   return data;
 }
 
-ChapterFrame::ChapterFrame(const ID3v2::Header *tagHeader, const ByteVector &data, Header *h) :
+ChapterFrame::ChapterFrame(const ID3v2::Header *tagHeader, const ByteVector &data, Header *h,
+                           bool lazy) :
   Frame(h),
   d(new ChapterFramePrivate())
 {
   d->tagHeader = tagHeader;
-  parseFields(fieldData(data));
+  if(lazy)
+    setPendingFields(fieldData(data));
+  else
+    parseFields(fieldData(data));
 }
@@ -236,7 +236,7 @@ namespace TagLib {
       virtual ByteVector renderFields() const;
 
     private:
-      ChapterFrame(const ID3v2::Header *tagHeader, const ByteVector &data, Header *h);
+      ChapterFrame(const ID3v2::Header *tagHeader, const ByteVector &data, Header *h, bool lazy);
       ChapterFrame(const ChapterFrame &);
       ChapterFrame &operator=(const ChapterFrame &);
 
@@ -70,6 +70,7 @@ GeneralEncapsulatedObjectFrame::~GeneralEncapsulatedObjectFrame()
 
 String GeneralEncapsulatedObjectFrame::toString() const
 {
+  parsePendingFields();
   String text = "[" + d->mimeType + "]";
 
   if(!d->fileName.isEmpty())
@@ -83,51 +84,61 @@ String GeneralEncapsulatedObjectFrame::toString() const
 
 String::Type GeneralEncapsulatedObjectFrame::textEncoding() const
 {
+  parsePendingFields();
   return d->textEncoding;
 }
 
 void GeneralEncapsulatedObjectFrame::setTextEncoding(String::Type encoding)
 {
+  parsePendingFields();
   d->textEncoding = encoding;
 }
 
 String GeneralEncapsulatedObjectFrame::mimeType() const
 {
+  parsePendingFields();
   return d->mimeType;
 }
 
 void GeneralEncapsulatedObjectFrame::setMimeType(const String &type)
 {
+  parsePendingFields();
   d->mimeType = type;
 }
 
 String GeneralEncapsulatedObjectFrame::fileName() const
 {
+  parsePendingFields();
   return d->fileName;
 }
 
 void GeneralEncapsulatedObjectFrame::setFileName(const String &name)
 {
+  parsePendingFields();
   d->fileName = name;
 }
 
 String GeneralEncapsulatedObjectFrame::description() const
 {
+  parsePendingFields();
   return d->description;
 }
 
 void GeneralEncapsulatedObjectFrame::setDescription(const String &desc)
 {
+  parsePendingFields();
   d->description = desc;
 }
 
 ByteVector GeneralEncapsulatedObjectFrame::object() const
 {
+  parsePendingFields();
   return d->data;
 }
 
 void GeneralEncapsulatedObjectFrame::setObject(const ByteVector &data)
 {
+  parsePendingFields();
   d->data = data;
 }
 
@@ -155,6 +166,7 @@ void GeneralEncapsulatedObjectFrame::parseFields(const ByteVector &data)
 
 ByteVector GeneralEncapsulatedObjectFrame::renderFields() const
 {
+  parsePendingFields();
   StringList sl;
   sl.append(d->fileName);
   sl.append(d->description);
@@ -179,9 +191,13 @@ ByteVector GeneralEncapsulatedObjectFrame::renderFields() const
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
-GeneralEncapsulatedObjectFrame::GeneralEncapsulatedObjectFrame(const ByteVector &data, Header *h) :
+GeneralEncapsulatedObjectFrame::GeneralEncapsulatedObjectFrame(const ByteVector &data, Header *h,
+                                                               bool lazy) :
   Frame(h),
   d(new GeneralEncapsulatedObjectFramePrivate())
 {
-  parseFields(fieldData(data));
+  if(lazy)
+    setPendingFields(fieldData(data));
+  else
+    parseFields(fieldData(data));
 }
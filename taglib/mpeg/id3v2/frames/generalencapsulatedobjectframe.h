@@ -166,7 +166,7 @@ namespace TagLib {
       virtual ByteVector renderFields() const;
 
     private:
-      GeneralEncapsulatedObjectFrame(const ByteVector &data, Header *h);
+      GeneralEncapsulatedObjectFrame(const ByteVector &data, Header *h, bool lazy);
       GeneralEncapsulatedObjectFrame(const GeneralEncapsulatedObjectFrame &);
       GeneralEncapsulatedObjectFrame &operator=(const GeneralEncapsulatedObjectFrame &);
 
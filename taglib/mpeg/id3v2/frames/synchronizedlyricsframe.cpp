@@ -72,69 +72,82 @@ SynchronizedLyricsFrame::~SynchronizedLyricsFrame()
 
 String SynchronizedLyricsFrame::toString() const
 {
+  parsePendingFields();
   return d->description;
 }
 
 String::Type SynchronizedLyricsFrame::textEncoding() const
 {
+  parsePendingFields();
   return d->textEncoding;
 }
 
 ByteVector SynchronizedLyricsFrame::language() const
 {
+  parsePendingFields();
   return d->language;
 }
 
 SynchronizedLyricsFrame::TimestampFormat
 SynchronizedLyricsFrame::timestampFormat() const
 {
+  parsePendingFields();
   return d->timestampFormat;
 }
 
 SynchronizedLyricsFrame::Type SynchronizedLyricsFrame::type() const
 {
+  parsePendingFields();
   return d->type;
 }
 
 String SynchronizedLyricsFrame::description() const
 {
+  parsePendingFields();
   return d->description;
 }
 
 SynchronizedLyricsFrame::SynchedTextList
 SynchronizedLyricsFrame::synchedText() const
 {
+  parsePendingFields();
   return d->synchedText;
 }
 
 void SynchronizedLyricsFrame::setTextEncoding(String::Type encoding)
 {
+  parsePendingFields();
   d->textEncoding = encoding;
 }
 
 void SynchronizedLyricsFrame::setLanguage(const ByteVector &languageEncoding)
 {
+  parsePendingFields();
   d->language = languageEncoding.mid(0, 3);
 }
 
 void SynchronizedLyricsFrame::setTimestampFormat(SynchronizedLyricsFrame::TimestampFormat f)
 {
+  parsePendingFields();
   d->timestampFormat = f;
 }
 
 void SynchronizedLyricsFrame::setType(SynchronizedLyricsFrame::Type t)
 {
+  parsePendingFields();
   d->type = t;
 }
 
 void SynchronizedLyricsFrame::setDescription(const String &s)
 {
+  parsePendingFields();
   d->description = s;
 }
 
 void SynchronizedLyricsFrame::setSynchedText(
     const SynchronizedLyricsFrame::SynchedTextList &t)
 {
+  parsePendingFields();
   d->synchedText = t;
 }
 
@@ -201,6 +214,7 @@ void SynchronizedLyricsFrame::parseFields(const ByteVector &data)
 
 ByteVector SynchronizedLyricsFrame::renderFields() const
 {
+  parsePendingFields();
   ByteVector v;
 
   String::Type encoding = d->textEncoding;
@@ -234,9 +248,12 @@ ByteVector SynchronizedLyricsFrame::renderFields() const
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
-SynchronizedLyricsFrame::SynchronizedLyricsFrame(const ByteVector &data, Header *h) :
+SynchronizedLyricsFrame::SynchronizedLyricsFrame(const ByteVector &data, Header *h, bool lazy) :
   Frame(h),
   d(new SynchronizedLyricsFramePrivate())
 {
-  parseFields(fieldData(data));
+  if(lazy)
+    setPendingFields(fieldData(data));
+  else
+    parseFields(fieldData(data));
 }
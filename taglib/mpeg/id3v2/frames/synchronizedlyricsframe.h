@@ -218,7 +218,7 @@ namespace TagLib {
       /*!
        * The constructor used by the FrameFactory.
        */
-      SynchronizedLyricsFrame(const ByteVector &data, Header *h);
+      SynchronizedLyricsFrame(const ByteVector &data, Header *h, bool lazy);
       SynchronizedLyricsFrame(const SynchronizedLyricsFrame &);
       SynchronizedLyricsFrame &operator=(const SynchronizedLyricsFrame &);
 
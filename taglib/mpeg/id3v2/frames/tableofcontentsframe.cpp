@@ -110,59 +110,70 @@ TableOfContentsFrame::~TableOfContentsFrame()
 
 ByteVector TableOfContentsFrame::elementID() const
 {
+  parsePendingFields();
   return d->elementID;
 }
 
 bool TableOfContentsFrame::isTopLevel() const
 {
+  parsePendingFields();
   return d->isTopLevel;
 }
 
 bool TableOfContentsFrame::isOrdered() const
 {
+  parsePendingFields();
   return d->isOrdered;
 }
 
 unsigned int TableOfContentsFrame::entryCount() const
 {
+  parsePendingFields();
   return d->childElements.size();
 }
 
 ByteVectorList TableOfContentsFrame::childElements() const
 {
+  parsePendingFields();
   return d->childElements;
 }
 
 void TableOfContentsFrame::setElementID(const ByteVector &eID)
 {
+  parsePendingFields();
   d->elementID = eID;
   strip(d->elementID);
 }
 
 void TableOfContentsFrame::setIsTopLevel(const bool &t)
 {
+  parsePendingFields();
   d->isTopLevel = t;
 }
 
 void TableOfContentsFrame::setIsOrdered(const bool &o)
 {
+  parsePendingFields();
   d->isOrdered = o;
 }
 
 void TableOfContentsFrame::setChildElements(const ByteVectorList &l)
 {
+  parsePendingFields();
   d->childElements = l;
   strip(d->childElements);
 }
 
 void TableOfContentsFrame::addChildElement(const ByteVector &cE)
 {
+  parsePendingFields();
   d->childElements.append(cE);
   strip(d->childElements);
 }
 
 void TableOfContentsFrame::removeChildElement(const ByteVector &cE)
 {
+  parsePendingFields();
   ByteVectorList::Iterator it = d->childElements.find(cE);
 
   if(it == d->childElements.end())
@@ -173,27 +184,32 @@ void TableOfContentsFrame::removeChildElement(const ByteVector &cE)
 
 const FrameListMap &TableOfContentsFrame::embeddedFrameListMap() const
 {
+  parsePendingFields();
   return d->embeddedFrameListMap;
 }
 
 const FrameList &TableOfContentsFrame::embeddedFrameList() const
 {
+  parsePendingFields();
   return d->embeddedFrameList;
 }
 
 const FrameList &TableOfContentsFrame::embeddedFrameList(const ByteVector &frameID) const
 {
+  parsePendingFields();
   return d->embeddedFrameListMap[frameID];
 }
 
 void TableOfContentsFrame::addEmbeddedFrame(Frame *frame)
 {
+  parsePendingFields();
   d->embeddedFrameList.append(frame);
   d->embeddedFrameListMap[frame->frameID()].append(frame);
 }
 
 void TableOfContentsFrame::removeEmbeddedFrame(Frame *frame, bool del)
 {
+  parsePendingFields();
   // remove the frame from the frame list
   FrameList::Iterator it = d->embeddedFrameList.find(frame);
   d->embeddedFrameList.erase(it);
@@ -209,6 +225,7 @@ void TableOfContentsFrame::removeEmbeddedFrame(Frame *frame, bool del)
 
 void TableOfContentsFrame::removeEmbeddedFrames(const ByteVector &id)
 {
+  parsePendingFields();
   FrameList l = d->embeddedFrameListMap[id];
   for(FrameList::ConstIterator it = l.begin(); it != l.end(); ++it)
     removeEmbeddedFrame(*it, true);
@@ -216,11 +233,13 @@ void TableOfContentsFrame::removeEmbeddedFrames(const ByteVector &id)
 
 String TableOfContentsFrame::toString() const
 {
+  parsePendingFields();
   return String();
 }
 
 PropertyMap TableOfContentsFrame::asProperties() const
 {
+  parsePendingFields();
   PropertyMap map;
 
   map.unsupportedData().append(frameID() + String("/") + d->elementID);
@@ -306,6 +325,7 @@ void TableOfContentsFrame::parseFields(const ByteVector &data)
 
 ByteVector TableOfContentsFrame::renderFields() const
 {
+  parsePendingFields();
   ByteVector data;
 
   data.append(d->elementID);
@@ -331,10 +351,13 @@ ByteVector TableOfContentsFrame::renderFields() const
 }
 
 TableOfContentsFrame::TableOfContentsFrame(const ID3v2::Header *tagHeader,
-                                           const ByteVector &data, Header *h) :
+                                           const ByteVector &data, Header *h, bool lazy) :
   Frame(h),
   d(new TableOfContentsFramePrivate())
 {
   d->tagHeader = tagHeader;
-  parseFields(fieldData(data));
+  if(lazy)
+    setPendingFields(fieldData(data));
+  else
+    parseFields(fieldData(data));
 }
@@ -245,7 +245,8 @@ namespace TagLib {
       virtual ByteVector renderFields() const;
 
     private:
-      TableOfContentsFrame(const ID3v2::Header *tagHeader, const ByteVector &data, Header *h);
+      TableOfContentsFrame(const ID3v2::Header *tagHeader, const ByteVector &data, Header *h,
+                           bool lazy);
       TableOfContentsFrame(const TableOfContentsFrame &);
       TableOfContentsFrame &operator=(const TableOfContentsFrame &);
 
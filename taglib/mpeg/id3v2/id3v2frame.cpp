@@ -25,6 +25,7 @@
 
 #include <bitset>
 
+#include <tbytereader.h>
 #include <tdebug.h>
 #include <tstringlist.h>
 #include <tzlib.h>
@@ -48,7 +49,8 @@ class Frame::FramePrivate
 {
 public:
   FramePrivate() :
-    header(0)
+    header(0),
+    hasPendingFields(false)
     {}
 
   ~FramePrivate()
@@ -57,17 +59,28 @@ public:
   }
 
   Frame::Header *header;
+
+  // The field data that setPendingFields() keeps until the fields are
+  // accessed.
+
+  ByteVector pendingFields;
+  bool hasPendingFields;
 };
 
 namespace
 {
-  bool isValidFrameID(const ByteVector &frameID)
+  // Returns true if the four bytes at \a offset in \a data are a valid
+  // frame ID.
+
+  bool isValidFrameID(const ByteVector &data, size_t offset)
   {
-    if(frameID.size() != 4)
+    Utils::ByteReader reader(data);
+    const char *frameID = reader.skip(offset) ? reader.read(4) : 0;
+    if(!frameID)
       return false;
 
-    for(ByteVector::ConstIterator it = frameID.begin(); it != frameID.end(); it++) {
-      if( (*it < 'A' || *it > 'Z') && (*it < '0' || *it > '9') ) {
+    for(int i = 0; i < 4; i++) {
+      if( (frameID[i] < 'A' || frameID[i] > 'Z') && (frameID[i] < '0' || frameID[i] > '9') ) {
         return false;
       }
     }
@@ -230,9 +243,33 @@ void Frame::parse(const ByteVector &data)
   else
     d->header = new Header(data);
 
+  d->pendingFields.clear();
+  d->hasPendingFields = false;
+
   parseFields(fieldData(data));
 }
 
+void Frame::setPendingFields(const ByteVector &data)
+{
+  d->pendingFields = data;
+  d->hasPendingFields = true;
+}
+
+void Frame::parsePendingFields() const
+{
+  if(!d->hasPendingFields)
+    return;
+
+  // Clear the pending data first, since parseFields() may call accessors
+  // which parse the pending fields themselves.
+
+  const ByteVector data = d->pendingFields;
+  d->pendingFields.clear();
+  d->hasPendingFields = false;
+
+  const_cast<Frame *>(this)->parseFields(data);
+}
+
 ByteVector Frame::fieldData(const ByteVector &frameData) const
 {
   unsigned int headerSize = Header::size(d->header->version());
@@ -599,6 +636,8 @@ void Frame::Header::setData(const ByteVector &data, unsigned int version)
 {
   d->version = version;
 
+  Utils::ByteReader reader(data);
+
   switch(version) {
   case 0:
   case 1:
@@ -613,7 +652,7 @@ void Frame::Header::setData(const ByteVector &data, unsigned int version)
 
     // Set the frame ID -- the first three bytes
 
-    d->frameID = data.mid(0, 3);
+    d->frameID = reader.readBlock(3);
 
     // If the full header information was not passed in, do not continue to the
     // steps to parse the frame size and flags.
@@ -623,7 +662,7 @@ void Frame::Header::setData(const ByteVector &data, unsigned int version)
       return;
     }
 
-    d->frameSize = data.toUInt(3, 3, true);
+    d->frameSize = reader.readUInt24();
 
     break;
   }
@@ -638,7 +677,7 @@ void Frame::Header::setData(const ByteVector &data, unsigned int version)
 
     // Set the frame ID -- the first four bytes
 
-    d->frameID = data.mid(0, 4);
+    d->frameID = reader.readBlock(4);
 
     // If the full header information was not passed in, do not continue to the
     // steps to parse the frame size and flags.
@@ -651,17 +690,17 @@ void Frame::Header::setData(const ByteVector &data, unsigned int version)
     // Set the size -- the frame size is the four bytes starting at byte four in
     // the frame header (structure 4)
 
-    d->frameSize = data.toUInt(4U);
+    d->frameSize = reader.readUInt();
 
     { // read the first byte of flags
-      std::bitset<8> flags(data[8]);
+      std::bitset<8> flags(reader.readByte());
       d->tagAlterPreservation  = flags[7]; // (structure 3.3.1.a)
       d->fileAlterPreservation = flags[6]; // (structure 3.3.1.b)
       d->readOnly              = flags[5]; // (structure 3.3.1.c)
     }
 
     { // read the second byte of flags
-      std::bitset<8> flags(data[9]);
+      std::bitset<8> flags(reader.readByte());
       d->compression         = flags[7]; // (structure 3.3.1.i)
       d->encryption          = flags[6]; // (structure 3.3.1.j)
       d->groupingIdentity    = flags[5]; // (structure 3.3.1.k)
@@ -680,7 +719,7 @@ void Frame::Header::setData(const ByteVector &data, unsigned int version)
 
     // Set the frame ID -- the first four bytes
 
-    d->frameID = data.mid(0, 4);
+    d->frameID = reader.readBlock(4);
 
     // If the full header information was not passed in, do not continue to the
     // steps to parse the frame size and flags.
@@ -691,15 +730,20 @@ void Frame::Header::setData(const ByteVector &data, unsigned int version)
     }
 
     // Set the size -- the frame size is the four bytes starting at byte four in
-    // the frame header (structure 4)
+    // the frame header (structure 4).  Like SynchData::toUInt(), this takes
+    // it as a normal integer if it is not synch safe.
 
-    d->frameSize = SynchData::toUInt(data.mid(4, 4));
+    const unsigned int uintSize = reader.readUInt();
+    if(uintSize & 0x80808080)
+      d->frameSize = uintSize;
+    else
+      d->frameSize = ((uintSize >> 3) & 0x0fe00000) | ((uintSize >> 2) & 0x001fc000) |
+                     ((uintSize >> 1) & 0x00003f80) | (uintSize & 0x0000007f);
 #ifndef NO_ITUNES_HACKS
     // iTunes writes v2.4 tags with v2.3-like frame sizes
     if(d->frameSize > 127) {
-      if(!isValidFrameID(data.mid(d->frameSize + 10, 4))) {
-        unsigned int uintSize = data.toUInt(4U);
-        if(isValidFrameID(data.mid(uintSize + 10, 4))) {
+      if(!isValidFrameID(data, d->frameSize + static_cast<size_t>(10))) {
+        if(isValidFrameID(data, uintSize + static_cast<size_t>(10))) {
           d->frameSize = uintSize;
         }
       }
@@ -707,14 +751,14 @@ void Frame::Header::setData(const ByteVector &data, unsigned int version)
 #endif
 
     { // read the first byte of flags
-      std::bitset<8> flags(data[8]);
+      std::bitset<8> flags(reader.readByte());
       d->tagAlterPreservation  = flags[6]; // (structure 4.1.1.a)
       d->fileAlterPreservation = flags[5]; // (structure 4.1.1.b)
       d->readOnly              = flags[4]; // (structure 4.1.1.c)
     }
 
     { // read the second byte of flags
-      std::bitset<8> flags(data[9]);
+      std::bitset<8> flags(reader.readByte());
       d->groupingIdentity    = flags[6]; // (structure 4.1.2.h)
       d->compression         = flags[3]; // (structure 4.1.2.k)
       d->encryption          = flags[2]; // (structure 4.1.2.m)
@@ -204,6 +204,20 @@ namespace TagLib {
        */
       virtual void parseFields(const ByteVector &data) = 0;
 
+      /*!
+       * Keeps the field data \a data to be parsed by parseFields() on the
+       * first call of parsePendingFields(), rather than parsing it now.
+       * Subclasses use this for a frame of FrameFactory::lazyParsing().
+       */
+      void setPendingFields(const ByteVector &data);
+
+      /*!
+       * Parses the field data kept by setPendingFields(), if there is any.
+       * Subclasses that use setPendingFields() call this in every method that
+       * reads or sets the parsed fields.
+       */
+      void parsePendingFields() const;
+
       /*!
        * Render the field data back to a binary format in a ByteVector.  This
        * must be overridden by subclasses.
@@ -90,10 +90,12 @@ class FrameFactory::FrameFactoryPrivate
 public:
   FrameFactoryPrivate() :
     defaultEncoding(String::Latin1),
-    useDefaultEncoding(false) {}
+    useDefaultEncoding(false),
+    lazyParsing(false) {}
 
   String::Type defaultEncoding;
   bool useDefaultEncoding;
+  bool lazyParsing;
 
   template <class T> void setTextEncoding(T *frame)
   {
@@ -224,7 +226,7 @@ Frame *FrameFactory::createFrame(const ByteVector &origData, Header *tagHeader)
   // Attached Picture (frames 4.14)
 
   if(frameID == "APIC") {
-    AttachedPictureFrame *f = new AttachedPictureFrame(data, header);
+    AttachedPictureFrame *f = new AttachedPictureFrame(data, header, d->lazyParsing);
     d->setTextEncoding(f);
     return f;
   }
@@ -250,7 +252,7 @@ Frame *FrameFactory::createFrame(const ByteVector &origData, Header *tagHeader)
   // General Encapsulated Object (frames 4.15)
 
   if(frameID == "GEOB") {
-    GeneralEncapsulatedObjectFrame *f = new GeneralEncapsulatedObjectFrame(data, header);
+    GeneralEncapsulatedObjectFrame *f = new GeneralEncapsulatedObjectFrame(data, header, d->lazyParsing);
     d->setTextEncoding(f);
     return f;
   }
@@ -280,7 +282,7 @@ Frame *FrameFactory::createFrame(const ByteVector &origData, Header *tagHeader)
   // Synchronised lyrics/text (frames 4.9)
 
   if(frameID == "SYLT") {
-    SynchronizedLyricsFrame *f = new SynchronizedLyricsFrame(data, header);
+    SynchronizedLyricsFrame *f = new SynchronizedLyricsFrame(data, header, d->lazyParsing);
     if(d->useDefaultEncoding)
       f->setTextEncoding(d->defaultEncoding);
     return f;
@@ -312,12 +314,12 @@ Frame *FrameFactory::createFrame(const ByteVector &origData, Header *tagHeader)
   // Chapter (ID3v2 chapters 1.0)
 
   if(frameID == "CHAP")
-    return new ChapterFrame(tagHeader, data, header);
+    return new ChapterFrame(tagHeader, data, header, d->lazyParsing);
 
   // Table of contents (ID3v2 chapters 1.0)
 
   if(frameID == "CTOC")
-    return new TableOfContentsFrame(tagHeader, data, header);
+    return new TableOfContentsFrame(tagHeader, data, header, d->lazyParsing);
 
   // Apple proprietary PCST (Podcast)
 
@@ -369,6 +371,16 @@ void FrameFactory::setDefaultTextEncoding(String::Type encoding)
   d->defaultEncoding = encoding;
 }
 
+bool FrameFactory::lazyParsing() const
+{
+  return d->lazyParsing;
+}
+
+void FrameFactory::setLazyParsing(bool lazy)
+{
+  d->lazyParsing = lazy;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // protected members
 ////////////////////////////////////////////////////////////////////////////////
@@ -123,6 +123,30 @@ namespace TagLib {
        */
       void setDefaultTextEncoding(String::Type encoding);
 
+      /*!
+       * Returns true if the bodies of the frames that are costly to parse are
+       * parsed when they are first accessed rather than when the tag is read.
+       *
+       * \see setLazyParsing()
+       */
+      bool lazyParsing() const;
+
+      /*!
+       * If \a lazy is true, only the headers of attached picture (APIC),
+       * general encapsulated object (GEOB), synchronized lyrics (SYLT),
+       * chapter (CHAP) and table of contents (CTOC) frames are parsed when a
+       * tag is read, and their bodies on the first access to the frame.  This
+       * saves the work for applications that only read some text frames.  The
+       * default is false.
+       *
+       * \note The first access modifies a frame even through a const method,
+       * so with lazy parsing a tag must not be read from several threads at
+       * once.
+       *
+       * \see lazyParsing()
+       */
+      void setLazyParsing(bool lazy);
+
     protected:
       /*!
        * Constructs a frame factory.  Because this is a singleton this method is
@@ -24,6 +24,7 @@
  ***************************************************************************/
 
 #include <iostream>
+#include <cstring>
 
 #include "id3v2synchdata.h"
 
@@ -76,23 +77,72 @@ ByteVector SynchData::decode(const ByteVector &data)
 {
   // We have this optimized method instead of using ByteVector::replace(),
   // since it makes a great difference when decoding huge unsynchronized frames.
+  // memchr() finds the next 0xFF, and the run of bytes up to it is copied
+  // at once.
 
   ByteVector result(data.size());
+  if(data.isEmpty())
+    return result;
 
-  ByteVector::ConstIterator src = data.begin();
-  ByteVector::Iterator dst = result.begin();
+  const char *src = data.data();
+  const char *const end = src + data.size();
+  char *const begin = result.data();
+  char *dst = begin;
 
-  while(src < data.end() - 1) {
-    *dst++ = *src++;
+  while(src < end) {
+    const char *ff = static_cast<const char *>(::memchr(src, '\xff', end - src));
+    const char *runEnd = ff ? ff + 1 : end;
 
-    if(*(src - 1) == '\xff' && *src == '\x00')
-      src++;
+    ::memcpy(dst, src, runEnd - src);
+    dst += runEnd - src;
+    src  = runEnd;
+
+    if(ff && src < end && *src == '\x00')
+      ++src;
   }
 
-  if(src < data.end())
-    *dst++ = *src++;
+  result.resize(static_cast<unsigned int>(dst - begin));
+
+  return result;
+}
+
+ByteVector SynchData::encode(const ByteVector &data)
+{
+  if(data.isEmpty())
+    return ByteVector();
+
+  const char *src = data.data();
+  const char *const end = src + data.size();
+
+  // Each 0xFF can grow into two bytes, so count them first.
+
+  unsigned int count = 0;
+  for(const char *p = src; (p = static_cast<const char *>(::memchr(p, '\xff', end - p))) != 0; ++p)
+    ++count;
+
+  if(count == 0)
+    return data;
+
+  ByteVector result(data.size() + count);
+  char *const begin = result.data();
+  char *dst = begin;
+
+  while(src < end) {
+    const char *ff = static_cast<const char *>(::memchr(src, '\xff', end - src));
+    const char *runEnd = ff ? ff + 1 : end;
+
+    ::memcpy(dst, src, runEnd - src);
+    dst += runEnd - src;
+    src  = runEnd;
+
+    // A zero is inserted after 0xFF when it is followed by zero, by a byte
+    // that would make it look like an MPEG sync, or by the end of the data.
+
+    if(ff && (src == end || *src == '\x00' || (static_cast<unsigned char>(*src) & 0xe0) == 0xe0))
+      *dst++ = '\x00';
+  }
 
-  result.resize(static_cast<unsigned int>(dst - result.begin()));
+  result.resize(static_cast<unsigned int>(dst - begin));
 
   return result;
 }
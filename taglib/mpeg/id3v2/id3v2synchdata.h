@@ -62,6 +62,13 @@ namespace TagLib {
        * Convert the data from unsynchronized data to its original format.
        */
       TAGLIB_EXPORT ByteVector decode(const ByteVector &input);
+
+      /*!
+       * Convert the data to unsynchronized data (Structure,
+       * <a href="id3v2-structure.html#6.1">6.1</a>).  This is the reverse of
+       * decode().
+       */
+      TAGLIB_EXPORT ByteVector encode(const ByteVector &input);
     }
 
   }
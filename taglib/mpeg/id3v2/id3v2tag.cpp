@@ -623,14 +623,26 @@ ByteVector ID3v2::Tag::render(int version) const
   long originalSize = d->header.tagSize();
   long paddingSize = originalSize - (tagData.size() - Header::size());
 
+  // If the file can grow by whole blocks without rewriting the rest of it,
+  // the padding is rounded up to make the tag grow that way.
+
+  const long alignment = d->file ? d->file->resizeAlignment() : 0;
+
   if(paddingSize <= 0) {
     paddingSize = MinPaddingSize;
+
+    if(alignment > 0) {
+      const long oldTagSize = (originalSize > 0) ? static_cast<long>(d->header.completeTagSize()) : 0;
+      const long growth = static_cast<long>(tagData.size()) + MinPaddingSize - oldTagSize;
+      paddingSize += (alignment - growth % alignment) % alignment;
+    }
   }
   else {
-    // Padding won't increase beyond 1% of the file size or 1MB.
+    // Padding won't increase beyond 1% of the file size or 1MB, but it may
+    // keep the extra space added when the file grew by whole blocks.
 
     long threshold = d->file ? d->file->length() / 100 : 0;
-    threshold = std::max(threshold, MinPaddingSize);
+    threshold = std::max(threshold, MinPaddingSize + alignment);
     threshold = std::min(threshold, MaxPaddingSize);
 
     if(paddingSize > threshold)
@@ -672,7 +684,7 @@ void ID3v2::Tag::read()
   if(!d->file)
     return;
 
-  if(!d->file->isOpen())
+  if(!d->file->isOpen() || d->tagOffset < 0)
     return;
 
   d->file->seek(d->tagOffset);
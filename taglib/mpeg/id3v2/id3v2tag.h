@@ -147,6 +147,9 @@ namespace TagLib {
        * \a factory specifies which FrameFactory will be used for the
        * construction of new frames.
        *
+       * If \a tagOffset is negative, nothing is read and the tag starts empty,
+       * but its padding is still chosen to suit \a file.
+       *
        * \note You should be able to ignore the \a factory parameter in almost
        * all situations.  You would want to specify your own FrameFactory
        * subclass in the case that you are extending TagLib to support additional
@@ -23,6 +23,9 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#include <algorithm>
+#include <cstring>
+
 #include <tagunion.h>
 #include <tagutils.h>
 #include <id3v2tag.h>
@@ -30,18 +33,116 @@
 #include <id3v1tag.h>
 #include <apefooter.h>
 #include <apetag.h>
+#include <tbytereader.h>
 #include <tdebug.h>
 
 #include "mpegfile.h"
 #include "mpegheader.h"
 #include "mpegutils.h"
+#include "xingheader.h"
+#include "vbriheader.h"
 #include "tpropertymap.h"
+#include "tpropertyhandlers.h"
 
 using namespace TagLib;
 
 namespace
 {
   enum { ID3v2Index = 0, APEIndex = 1, ID3v1Index = 2 };
+
+  // frameIndex() reads the stream in blocks of this size, so that it mostly
+  // costs one read per block.
+
+  const long FrameWalkBufferSize = 64 * 1024;
+
+  // Reads frame headers in the range of the stream that is not covered by
+  // tags.
+
+  class FrameHeaderReader
+  {
+  public:
+    FrameHeaderReader(MPEG::File *file, long end) :
+      file(file),
+      end(end),
+      bufferOffset(0) {}
+
+    // Reads the four bytes at \a offset into \a header, most significant
+    // byte first.  Returns false if they are past the end of the stream.
+
+    bool read(long offset, unsigned int &header)
+    {
+      if(offset < 0 || offset > end - 4)
+        return false;
+
+      if(offset < bufferOffset || offset + 4 > bufferOffset + static_cast<long>(buffer.size())) {
+        file->seek(offset);
+        buffer = file->readBlock(std::min(FrameWalkBufferSize, end - offset));
+        bufferOffset = offset;
+
+        if(buffer.size() < 4)
+          return false;
+      }
+
+      Utils::ByteReader reader(buffer.data() + (offset - bufferOffset), 4);
+      header = reader.readUInt();
+      return true;
+    }
+
+  private:
+    MPEG::File *file;
+    const long end;
+    ByteVector buffer;
+    long bufferOffset;
+  };
+
+  // Reads the four bytes at \a offset into \a header, most significant byte
+  // first.  They are taken from \a buffer, which holds the data at
+  // \a bufferOffset, and only read from the file if they are not in it.
+
+  bool readFrameHeader(MPEG::File *file, const ByteVector &buffer, long bufferOffset,
+                       long offset, unsigned int &header)
+  {
+    if(offset >= bufferOffset && offset + 4 <= bufferOffset + static_cast<long>(buffer.size())) {
+      header = buffer.toUInt(static_cast<unsigned int>(offset - bufferOffset), true);
+      return true;
+    }
+
+    if(offset < 0)
+      return false;
+
+    file->seek(offset);
+    const ByteVector data = file->readBlock(4);
+    if(data.size() < 4)
+      return false;
+
+    header = data.toUInt(0, true);
+    return true;
+  }
+
+  // Returns the length of the frame at \a offset if it has a valid header
+  // which the header of the next frame is consistent with, or 0 otherwise.
+  // This is the check of Header(file, offset, true), but the frame scanners
+  // can do it on the data they have already read.
+
+  int checkedFrameLength(MPEG::File *file, const ByteVector &buffer, long bufferOffset,
+                         long offset)
+  {
+    unsigned int header;
+    if(!readFrameHeader(file, buffer, bufferOffset, offset, header))
+      return 0;
+
+    int samples;
+    const int length = MPEG::frameLength(header, samples);
+    if(length == 0)
+      return 0;
+
+    unsigned int nextHeader;
+    if(!readFrameHeader(file, buffer, bufferOffset, offset + length, nextHeader) ||
+       (nextHeader & MPEG::FrameHeaderMask) != (header & MPEG::FrameHeaderMask))
+      return 0;
+
+    return length;
+  }
 }
 
 class MPEG::File::FilePrivate
@@ -80,30 +181,36 @@ public:
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-MPEG::File::File(FileName file, bool readProperties, Properties::ReadStyle) :
+MPEG::File::File(FileName file, bool readProperties, Properties::ReadStyle readStyle) :
   TagLib::File(file),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
-    read(readProperties);
+    read(readProperties, readStyle);
 }
 
 MPEG::File::File(FileName file, ID3v2::FrameFactory *frameFactory,
-                 bool readProperties, Properties::ReadStyle) :
+                 bool readProperties, Properties::ReadStyle readStyle) :
   TagLib::File(file),
   d(new FilePrivate(frameFactory))
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
-    read(readProperties);
+    read(readProperties, readStyle);
 }
 
 MPEG::File::File(IOStream *stream, ID3v2::FrameFactory *frameFactory,
-                 bool readProperties, Properties::ReadStyle) :
+                 bool readProperties, Properties::ReadStyle readStyle) :
   TagLib::File(stream),
   d(new FilePrivate(frameFactory))
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
-    read(readProperties);
+    read(readProperties, readStyle);
 }
 
 MPEG::File::~File()
@@ -168,6 +275,8 @@ bool MPEG::File::save(int tags, bool stripOthers, int id3v2Version, bool duplica
     return false;
   }
 
+  SaveScope scope(this);
+
   // Create the tags if we've been asked to.
 
   if(duplicateTags) {
@@ -273,7 +382,12 @@ bool MPEG::File::save(int tags, bool stripOthers, int id3v2Version, bool duplica
 
 ID3v2::Tag *MPEG::File::ID3v2Tag(bool create)
 {
-  return d->tag.access<ID3v2::Tag>(ID3v2Index, create);
+  // A new tag is bound to this file, so that its padding fits the file.
+
+  if(create && !d->tag[ID3v2Index])
+    d->tag.set(ID3v2Index, new ID3v2::Tag(this, -1, d->ID3v2FrameFactory));
+
+  return d->tag.access<ID3v2::Tag>(ID3v2Index, false);
 }
 
 ID3v1::Tag *MPEG::File::ID3v1Tag(bool create)
@@ -298,6 +412,8 @@ bool MPEG::File::strip(int tags, bool freeMemory)
     return false;
   }
 
+  SaveScope scope(this);
+
   if((tags & ID3v2) && d->ID3v2Location >= 0) {
     removeBlock(d->ID3v2Location, d->ID3v2OriginalSize);
 
@@ -346,32 +462,27 @@ void MPEG::File::setID3v2FrameFactory(const ID3v2::FrameFactory *factory)
 
 long MPEG::File::nextFrameOffset(long position)
 {
-  ByteVector frameSyncBytes(2, '\0');
-
   while(true) {
     seek(position);
     const ByteVector buffer = readBlock(bufferSize());
     if(buffer.isEmpty())
       return -1;
 
-    for(unsigned int i = 0; i < buffer.size(); ++i) {
-      frameSyncBytes[0] = frameSyncBytes[1];
-      frameSyncBytes[1] = buffer[i];
-      if(isFrameSync(frameSyncBytes)) {
-        const Header header(this, position + i - 1, true);
-        if(header.isValid())
-          return position + i - 1;
-      }
+    const char *const begin = buffer.data();
+    const char *const end   = begin + buffer.size();
+
+    for(const char *p = begin; (p = static_cast<const char *>(::memchr(p, '\xff', end - p))) != 0; ++p) {
+      const long offset = position + static_cast<long>(p - begin);
+      if(checkedFrameLength(this, buffer, position, offset) > 0)
+        return offset;
     }
 
-    position += bufferSize();
+    position += buffer.size();
   }
 }
 
 long MPEG::File::previousFrameOffset(long position)
 {
-  ByteVector frameSyncBytes(2, '\0');
-
   while(position > 0) {
     const long bufferLength = std::min<long>(position, bufferSize());
     position -= bufferLength;
@@ -380,13 +491,12 @@ long MPEG::File::previousFrameOffset(long position)
     const ByteVector buffer = readBlock(bufferLength);
 
     for(int i = buffer.size() - 1; i >= 0; --i) {
-      frameSyncBytes[1] = frameSyncBytes[0];
-      frameSyncBytes[0] = buffer[i];
-      if(isFrameSync(frameSyncBytes)) {
-        const Header header(this, position + i, true);
-        if(header.isValid())
-          return position + i + header.frameLength();
-      }
+      if(buffer[i] != '\xff')
+        continue;
+
+      const int frameLength = checkedFrameLength(this, buffer, position, position + i);
+      if(frameLength > 0)
+        return position + i + frameLength;
     }
   }
 
@@ -417,6 +527,87 @@ long MPEG::File::lastFrameOffset()
   return previousFrameOffset(position);
 }
 
+MPEG::FrameIndex MPEG::File::frameIndex(unsigned int interval)
+{
+  const long firstHeaderOffset = firstFrameOffset();
+  if(firstHeaderOffset < 0) {
+    debug("MPEG::File::frameIndex() -- Could not find a valid first MPEG frame in the stream.");
+    return FrameIndex();
+  }
+
+  const Header firstHeader(this, firstHeaderOffset, false);
+  if(!firstHeader.isValid() || firstHeader.sampleRate() <= 0) {
+    debug("MPEG::File::frameIndex() -- The first frame header is invalid.");
+    return FrameIndex();
+  }
+
+  long end;
+  if(hasAPETag())
+    end = d->APELocation;
+  else if(hasID3v1Tag())
+    end = d->ID3v1Location;
+  else
+    end = length();
+
+  // The frame that holds a VBR header has no audio.
+
+  long offset = firstHeaderOffset;
+
+  seek(firstHeaderOffset + 4);
+  if(XingHeader(readBlock(firstHeader.frameLength() - 4)).isValid()) {
+    offset += firstHeader.frameLength();
+  }
+  else {
+    seek(firstHeaderOffset + 4 + 32);
+    if(VbriHeader(readBlock(24)).isValid())
+      offset += firstHeader.frameLength();
+  }
+
+  // All the frames have to be consistent with the first one.  When the walk
+  // loses synch, e.g. on garbage between the frames, it continues at the
+  // next frame that is followed by another one.  A frame that is cut off by
+  // the end of the stream is not counted.
+
+  FrameIndex index(interval, firstHeader.sampleRate());
+  FrameHeaderReader reader(this, end);
+
+  unsigned int reference;
+  if(!reader.read(firstHeaderOffset, reference))
+    return index;
+
+  reference &= FrameHeaderMask;
+
+  unsigned int header;
+  while(reader.read(offset, header)) {
+    int samples = 0;
+    int frameLength = MPEG::frameLength(header, samples);
+
+    if(frameLength == 0 || (header & FrameHeaderMask) != reference) {
+      bool found = false;
+      while(!found && reader.read(++offset, header)) {
+        frameLength = MPEG::frameLength(header, samples);
+        if(frameLength > 0 && (header & FrameHeaderMask) == reference) {
+          unsigned int nextHeader;
+          found = (offset + frameLength == end ||
+                   (reader.read(offset + frameLength, nextHeader) &&
+                    (nextHeader & FrameHeaderMask) == reference));
+        }
+      }
+
+      if(!found)
+        break;
+    }
+
+    if(offset + frameLength > end)
+      break;
+
+    index.addFrame(offset, frameLength, samples);
+    offset += frameLength;
+  }
+
+  return index;
+}
+
 bool MPEG::File::hasID3v1Tag() const
 {
   return (d->ID3v1Location >= 0);
@@ -436,7 +627,7 @@ bool MPEG::File::hasAPETag() const
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
-void MPEG::File::read(bool readProperties)
+void MPEG::File::read(bool readProperties, Properties::ReadStyle readStyle)
 {
   // Look for an ID3v2 tag
 
@@ -447,17 +638,13 @@ void MPEG::File::read(bool readProperties)
     d->ID3v2OriginalSize = ID3v2Tag()->header()->completeTagSize();
   }
 
-  // Look for an ID3v1 tag
+  // Look for ID3v1 and APE tags
 
-  d->ID3v1Location = Utils::findID3v1(this);
+  Utils::findTags(this, 0, &d->ID3v1Location, &d->APELocation);
 
   if(d->ID3v1Location >= 0)
     d->tag.set(ID3v1Index, new ID3v1::Tag(this, d->ID3v1Location));
 
-  // Look for an APE tag
-
-  d->APELocation = Utils::findAPE(this, d->ID3v1Location);
-
   if(d->APELocation >= 0) {
     d->tag.set(APEIndex, new APE::Tag(this, d->APELocation));
     d->APEOriginalSize = APETag()->footer()->completeTagSize();
@@ -465,7 +652,7 @@ void MPEG::File::read(bool readProperties)
   }
 
   if(readProperties)
-    d->properties = new Properties(this);
+    d->properties = new Properties(this, readStyle);
 
   // Make sure that we have our default tag types available.
 
@@ -486,14 +673,8 @@ long MPEG::File::findID3v2()
   if(readBlock(headerID.size()) == headerID)
     return 0;
 
-  const Header firstHeader(this, 0, true);
-  if(firstHeader.isValid())
-    return -1;
-
   // Look for an ID3v2 tag until reaching the first valid MPEG frame.
 
-  ByteVector frameSyncBytes(2, '\0');
-  ByteVector tagHeaderBytes(3, '\0');
   long position = 0;
 
   while(true) {
@@ -503,21 +684,24 @@ long MPEG::File::findID3v2()
       return -1;
 
     for(unsigned int i = 0; i < buffer.size(); ++i) {
-      frameSyncBytes[0] = frameSyncBytes[1];
-      frameSyncBytes[1] = buffer[i];
-      if(isFrameSync(frameSyncBytes)) {
-        const Header header(this, position + i - 1, true);
-        if(header.isValid())
+      if(buffer[i] == '\xff') {
+        if(checkedFrameLength(this, buffer, position, position + i) > 0)
           return -1;
       }
+      else if(buffer[i] == headerID[0]) {
+        if(buffer.containsAt(headerID, i))
+          return position + i;
 
-      tagHeaderBytes[0] = tagHeaderBytes[1];
-      tagHeaderBytes[1] = tagHeaderBytes[2];
-      tagHeaderBytes[2] = buffer[i];
-      if(tagHeaderBytes == headerID)
-        return position + i - 2;
+        // The identifier may continue in the next block.
+
+        if(i + headerID.size() > buffer.size()) {
+          seek(position + i);
+          if(readBlock(headerID.size()) == headerID)
+            return position + i;
+        }
+      }
     }
 
-    position += bufferSize();
+    position += buffer.size();
   }
 }
@@ -31,6 +31,7 @@
 #include "tag.h"
 
 #include "mpegproperties.h"
+#include "mpegframeindex.h"
 
 namespace TagLib {
 
@@ -74,7 +75,8 @@ namespace TagLib {
        * Constructs an MPEG file from \a file.  If \a readProperties is true the
        * file's audio properties will also be read.
        *
-       * \note In the current implementation, \a propertiesStyle is ignored.
+       * With \a propertiesStyle set to Accurate, the length and the bitrate are
+       * computed from all the frames of the stream.
        *
        * \deprecated This constructor will be dropped in favor of the one below
        * in a future version.
@@ -89,7 +91,8 @@ namespace TagLib {
        * If this file contains and ID3v2 tag the frames will be created using
        * \a frameFactory.
        *
-       * \note In the current implementation, \a propertiesStyle is ignored.
+       * With \a propertiesStyle set to Accurate, the length and the bitrate are
+       * computed from all the frames of the stream.
        */
       // BIC: merge with the above constructor
       File(FileName file, ID3v2::FrameFactory *frameFactory,
@@ -106,7 +109,8 @@ namespace TagLib {
        * If this file contains and ID3v2 tag the frames will be created using
        * \a frameFactory.
        *
-       * \note In the current implementation, \a propertiesStyle is ignored.
+       * With \a propertiesStyle set to Accurate, the length and the bitrate are
+       * computed from all the frames of the stream.
        */
       File(IOStream *stream, ID3v2::FrameFactory *frameFactory,
            bool readProperties = true,
@@ -349,6 +353,21 @@ namespace TagLib {
        */
       long lastFrameOffset();
 
+      /*!
+       * Walks all the frames of the stream and returns an index of them.
+       * Every \a interval-th frame is in the index, starting with the first
+       * one, so that 1 indexes every frame and larger values trade the
+       * precision of FrameIndex::findTime() for memory.  With an \a interval
+       * of 0 the index holds only the totals of the stream.
+       *
+       * The frame that holds a Xing or VBRI header is not in the index, and
+       * garbage between the frames is skipped.
+       *
+       * \note This reads the whole stream, so it is usually done once and
+       * the result cached with FrameIndex::render().
+       */
+      FrameIndex frameIndex(unsigned int interval = 1);
+
       /*!
        * Returns whether or not the file on disk actually has an ID3v1 tag.
        *
@@ -374,7 +393,7 @@ namespace TagLib {
       File(const File &);
       File &operator=(const File &);
 
-      void read(bool readProperties);
+      void read(bool readProperties, Properties::ReadStyle readStyle);
       long findID3v2();
 
       class FilePrivate;
@@ -0,0 +1,306 @@
+/***************************************************************************
+    copyright            : (C) 2026 by the TagLib developers
+    email                :
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include <vector>
+
+#include <tbytereader.h>
+#include <tdebug.h>
+#include <trefcounter.h>
+
+#include "mpegframeindex.h"
+
+using namespace TagLib;
+
+namespace
+{
+  // The rendered index starts with this and a version number, followed by
+  // the interval, the sample rate, the number of frames, the number of
+  // samples and the length of the stream, and the number of entries.  Each
+  // entry is the difference of its offset to that of the previous entry,
+  // its length and the difference of its sample to that of the previous
+  // entry as variable length integers, with 7 bits in each byte and the
+  // high bit set on all but the last.
+
+  const char IndexMagic[] = "TLFI";
+  const unsigned int IndexMagicSize = 4;
+  const unsigned char IndexVersion = 1;
+
+  const unsigned int MaxNumberSize = 10;
+
+  char *writeNumber(char *p, unsigned long long value)
+  {
+    while(value >= 0x80) {
+      *p++ = static_cast<char>((value & 0x7f) | 0x80);
+      value >>= 7;
+    }
+    *p++ = static_cast<char>(value);
+    return p;
+  }
+
+  unsigned long long readNumber(Utils::ByteReader &reader)
+  {
+    unsigned long long value = 0;
+    for(int shift = 0; shift < 64; shift += 7) {
+      const unsigned char byte = reader.readByte();
+      value |= static_cast<unsigned long long>(byte & 0x7f) << shift;
+      if(!(byte & 0x80))
+        return value;
+    }
+
+    // Too long for 64 bits.
+
+    reader.skip(reader.remaining() + 1);
+    return 0;
+  }
+}
+
+class MPEG::FrameIndex::FrameIndexPrivate : public RefCounter
+{
+public:
+  FrameIndexPrivate() :
+    interval(1),
+    sampleRate(0),
+    frameCount(0),
+    sampleCount(0),
+    streamLength(0) {}
+
+  unsigned int interval;
+  int sampleRate;
+  long long frameCount;
+  long long sampleCount;
+  long long streamLength;
+  std::vector<Entry> entries;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+MPEG::FrameIndex::FrameIndex() :
+  d(new FrameIndexPrivate())
+{
+}
+
+MPEG::FrameIndex::FrameIndex(const ByteVector &data) :
+  d(new FrameIndexPrivate())
+{
+  Utils::ByteReader reader(data);
+
+  if(!reader.startsWith(IndexMagic, IndexMagicSize)) {
+    debug("MPEG::FrameIndex::FrameIndex() -- Not a frame index.");
+    return;
+  }
+
+  reader.skip(IndexMagicSize);
+
+  if(reader.readByte() != IndexVersion) {
+    debug("MPEG::FrameIndex::FrameIndex() -- Unsupported frame index version.");
+    return;
+  }
+
+  FrameIndexPrivate *p = new FrameIndexPrivate();
+  p->interval     = reader.readUInt();
+  p->sampleRate   = static_cast<int>(reader.readUInt());
+  p->frameCount   = static_cast<long long>(reader.readULongLong());
+  p->sampleCount  = static_cast<long long>(reader.readULongLong());
+  p->streamLength = static_cast<long long>(reader.readULongLong());
+
+  // Each entry takes at least three bytes.
+
+  const unsigned int count = reader.readUInt();
+  if(count <= reader.remaining() / 3)
+    p->entries.reserve(count);
+
+  Entry entry;
+  entry.offset = 0;
+  for(unsigned int i = 0; i < count && reader.isValid(); ++i) {
+    entry.offset += static_cast<long>(readNumber(reader));
+    entry.length  = static_cast<int>(readNumber(reader));
+    entry.sample += static_cast<long long>(readNumber(reader));
+    p->entries.push_back(entry);
+  }
+
+  if(!reader.isValid()) {
+    debug("MPEG::FrameIndex::FrameIndex() -- The frame index is truncated.");
+    delete p;
+    return;
+  }
+
+  delete d;
+  d = p;
+}
+
+MPEG::FrameIndex::FrameIndex(const FrameIndex &index) :
+  d(index.d)
+{
+  d->ref();
+}
+
+MPEG::FrameIndex::~FrameIndex()
+{
+  if(d->deref())
+    delete d;
+}
+
+MPEG::FrameIndex &MPEG::FrameIndex::operator=(const FrameIndex &index)
+{
+  if(&index == this)
+    return *this;
+
+  if(d->deref())
+    delete d;
+
+  d = index.d;
+  d->ref();
+  return *this;
+}
+
+bool MPEG::FrameIndex::isEmpty() const
+{
+  return d->entries.empty();
+}
+
+unsigned int MPEG::FrameIndex::size() const
+{
+  return static_cast<unsigned int>(d->entries.size());
+}
+
+MPEG::FrameIndex::Entry MPEG::FrameIndex::entry(unsigned int index) const
+{
+  if(index >= d->entries.size())
+    return Entry();
+
+  return d->entries[index];
+}
+
+unsigned int MPEG::FrameIndex::interval() const
+{
+  return d->interval;
+}
+
+int MPEG::FrameIndex::sampleRate() const
+{
+  return d->sampleRate;
+}
+
+long long MPEG::FrameIndex::frameCount() const
+{
+  return d->frameCount;
+}
+
+long long MPEG::FrameIndex::sampleCount() const
+{
+  return d->sampleCount;
+}
+
+long long MPEG::FrameIndex::streamLength() const
+{
+  return d->streamLength;
+}
+
+MPEG::FrameIndex::Entry MPEG::FrameIndex::findSample(long long sample) const
+{
+  if(d->entries.empty())
+    return Entry();
+
+  // Find the first entry after sample; the one before it is the result.
+
+  size_t first = 0;
+  size_t last  = d->entries.size();
+  while(first < last) {
+    const size_t middle = first + (last - first) / 2;
+    if(d->entries[middle].sample <= sample)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+
+  return d->entries[first > 0 ? first - 1 : 0];
+}
+
+MPEG::FrameIndex::Entry MPEG::FrameIndex::findTime(int milliseconds) const
+{
+  return findSample(static_cast<long long>(milliseconds) * d->sampleRate / 1000);
+}
+
+ByteVector MPEG::FrameIndex::render() const
+{
+  ByteVector data(IndexMagic, IndexMagicSize);
+  data.append(static_cast<char>(IndexVersion));
+  data.append(ByteVector::fromUInt(d->interval));
+  data.append(ByteVector::fromUInt(static_cast<unsigned int>(d->sampleRate)));
+  data.append(ByteVector::fromLongLong(d->frameCount));
+  data.append(ByteVector::fromLongLong(d->sampleCount));
+  data.append(ByteVector::fromLongLong(d->streamLength));
+  data.append(ByteVector::fromUInt(size()));
+
+  // Write the entries into space for the longest numbers and cut off what is
+  // left over.
+
+  const unsigned int headerSize = data.size();
+  data.resize(headerSize + size() * 3 * MaxNumberSize);
+
+  char *const begin = data.data() + headerSize;
+  char *p = begin;
+
+  long offset = 0;
+  long long sample = 0;
+  for(std::vector<Entry>::const_iterator it = d->entries.begin(); it != d->entries.end(); ++it) {
+    p = writeNumber(p, it->offset - offset);
+    p = writeNumber(p, it->length);
+    p = writeNumber(p, it->sample - sample);
+    offset = it->offset;
+    sample = it->sample;
+  }
+
+  data.resize(headerSize + static_cast<unsigned int>(p - begin));
+  return data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// private members
+////////////////////////////////////////////////////////////////////////////////
+
+MPEG::FrameIndex::FrameIndex(unsigned int interval, int sampleRate) :
+  d(new FrameIndexPrivate())
+{
+  d->interval   = interval;
+  d->sampleRate = sampleRate;
+}
+
+void MPEG::FrameIndex::addFrame(long offset, int length, int samples)
+{
+  if(d->interval > 0 && d->frameCount % d->interval == 0) {
+    Entry entry;
+    entry.offset = offset;
+    entry.length = length;
+    entry.sample = d->sampleCount;
+    d->entries.push_back(entry);
+  }
+
+  d->frameCount++;
+  d->sampleCount  += samples;
+  d->streamLength += length;
+}
@@ -0,0 +1,172 @@
+/***************************************************************************
+    copyright            : (C) 2026 by the TagLib developers
+    email                :
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_MPEGFRAMEINDEX_H
+#define TAGLIB_MPEGFRAMEINDEX_H
+
+#include "tbytevector.h"
+#include "taglib_export.h"
+
+namespace TagLib {
+
+  namespace MPEG {
+
+    class File;
+
+    //! An index of the frames of an MPEG stream
+
+    /*!
+     * This maps positions in time to the offsets of the frames in an MPEG
+     * file, e.g. to serve a time range of a VBR file as a byte range.  It is
+     * built by File::frameIndex() in a single pass over the stream and holds
+     * the offset, the length and the position in samples of every frame, or
+     * of every n-th frame.
+     *
+     * An index can be saved with render() and restored with
+     * FrameIndex(const ByteVector &), so that it does not have to be built
+     * again as long as the file is not modified.
+     */
+
+    class TAGLIB_EXPORT FrameIndex
+    {
+    public:
+      /*!
+       * A frame in the index.
+       */
+      struct Entry
+      {
+        Entry() : offset(-1), length(0), sample(0) {}
+
+        //! The offset of the frame in the file, or -1 if there is no frame.
+        long offset;
+        //! The length of the frame in bytes.
+        int length;
+        //! The number of samples in the stream before this frame.
+        long long sample;
+      };
+
+      /*!
+       * Constructs an empty index.
+       */
+      FrameIndex();
+
+      /*!
+       * Constructs an index from \a data, as returned by render().  If
+       * \a data is not a valid index, the index is empty.
+       */
+      explicit FrameIndex(const ByteVector &data);
+
+      /*!
+       * Constructs a copy of \a index.
+       */
+      FrameIndex(const FrameIndex &index);
+
+      /*!
+       * Destroys this FrameIndex instance.
+       */
+      ~FrameIndex();
+
+      /*!
+       * Copies the contents of \a index into this index.
+       */
+      FrameIndex &operator=(const FrameIndex &index);
+
+      /*!
+       * Returns true if the index has no entries.
+       */
+      bool isEmpty() const;
+
+      /*!
+       * Returns the number of entries in the index.
+       */
+      unsigned int size() const;
+
+      /*!
+       * Returns the entry at \a index, or an entry with an offset of -1 if
+       * \a index is out of range.
+       */
+      Entry entry(unsigned int index) const;
+
+      /*!
+       * Returns the number of frames from one entry to the next.  1 means
+       * that every frame is in the index.
+       */
+      unsigned int interval() const;
+
+      /*!
+       * Returns the sample rate of the stream in Hz.
+       */
+      int sampleRate() const;
+
+      /*!
+       * Returns the number of frames in the stream, including those which are
+       * not in the index.
+       */
+      long long frameCount() const;
+
+      /*!
+       * Returns the number of samples in the stream.
+       */
+      long long sampleCount() const;
+
+      /*!
+       * Returns the total length of the frames in bytes.
+       */
+      long long streamLength() const;
+
+      /*!
+       * Returns the entry of the last frame in the index that starts at or
+       * before \a sample, or an entry with an offset of -1 if the index is
+       * empty.  Playback from its offset includes \a sample.
+       */
+      Entry findSample(long long sample) const;
+
+      /*!
+       * Returns the entry of the last frame in the index that starts at or
+       * before \a milliseconds.
+       *
+       * \see findSample()
+       */
+      Entry findTime(int milliseconds) const;
+
+      /*!
+       * Renders the index into a compact form that can be passed to
+       * FrameIndex(const ByteVector &).
+       */
+      ByteVector render() const;
+
+    private:
+      friend class File;
+
+      FrameIndex(unsigned int interval, int sampleRate);
+      void addFrame(long offset, int length, int samples);
+
+      class FrameIndexPrivate;
+      FrameIndexPrivate *d;
+    };
+  }
+}
+
+#endif
@@ -221,19 +221,6 @@ void MPEG::Header::parse(File *file, long offset, bool checkLength)
 
   // Set the bitrate
 
-  static const int bitrates[2][3][16] = {
-    { // Version 1
-      { 0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448, 0 }, // layer 1
-      { 0, 32, 48, 56, 64,  80,  96,  112, 128, 160, 192, 224, 256, 320, 384, 0 }, // layer 2
-      { 0, 32, 40, 48, 56,  64,  80,  96,  112, 128, 160, 192, 224, 256, 320, 0 }  // layer 3
-    },
-    { // Version 2 or 2.5
-      { 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256, 0 }, // layer 1
-      { 0, 8,  16, 24, 32, 40, 48, 56,  64,  80,  96,  112, 128, 144, 160, 0 }, // layer 2
-      { 0, 8,  16, 24, 32, 40, 48, 56,  64,  80,  96,  112, 128, 144, 160, 0 }  // layer 3
-    }
-  };
-
   const int versionIndex = (d->version == Version1) ? 0 : 1;
   const int layerIndex   = (d->layer > 0) ? d->layer - 1 : 0;
 
@@ -242,7 +229,7 @@ void MPEG::Header::parse(File *file, long offset, bool checkLength)
 
   const int bitrateIndex = (static_cast<unsigned char>(data[2]) >> 4) & 0x0F;
 
-  d->bitrate = bitrates[versionIndex][layerIndex][bitrateIndex];
+  d->bitrate = frameBitrates[versionIndex][layerIndex][bitrateIndex];
 
   if(d->bitrate == 0) {
     debug("MPEG::Header::parse() -- Invalid bit rate.");
@@ -251,17 +238,11 @@ void MPEG::Header::parse(File *file, long offset, bool checkLength)
 
   // Set the sample rate
 
-  static const int sampleRates[3][4] = {
-    { 44100, 48000, 32000, 0 }, // Version 1
-    { 22050, 24000, 16000, 0 }, // Version 2
-    { 11025, 12000, 8000,  0 }  // Version 2.5
-  };
-
   // The sample rate index is encoded as two bits in the 3nd byte, i.e. xxxx11xx
 
   const int samplerateIndex = (static_cast<unsigned char>(data[2]) >> 2) & 0x03;
 
-  d->sampleRate = sampleRates[d->version][samplerateIndex];
+  d->sampleRate = frameSampleRates[d->version][samplerateIndex];
 
   if(d->sampleRate == 0) {
     debug("MPEG::Header::parse() -- Invalid sample rate.");
@@ -281,23 +262,14 @@ void MPEG::Header::parse(File *file, long offset, bool checkLength)
 
   // Samples per frame
 
-  static const int samplesPerFrame[3][2] = {
-    // MPEG1, 2/2.5
-    {  384,   384 }, // Layer I
-    { 1152,  1152 }, // Layer II
-    { 1152,   576 }  // Layer III
-  };
-
-  d->samplesPerFrame = samplesPerFrame[layerIndex][versionIndex];
+  d->samplesPerFrame = frameSamples[layerIndex][versionIndex];
 
   // Calculate the frame length
 
-  static const int paddingSize[3] = { 4, 1, 1 };
-
   d->frameLength = d->samplesPerFrame * d->bitrate * 125 / d->sampleRate;
 
   if(d->isPadded)
-    d->frameLength += paddingSize[layerIndex];
+    d->frameLength += framePaddingSizes[layerIndex];
 
   if(checkLength) {
 
@@ -316,10 +288,8 @@ void MPEG::Header::parse(File *file, long offset, bool checkLength)
       return;
     }
 
-    const unsigned int HeaderMask = 0xfffe0c00;
-
-    const unsigned int header     = data.toUInt(0, true)     & HeaderMask;
-    const unsigned int nextHeader = nextData.toUInt(0, true) & HeaderMask;
+    const unsigned int header     = data.toUInt(0, true)     & FrameHeaderMask;
+    const unsigned int nextHeader = nextData.toUInt(0, true) & FrameHeaderMask;
 
     if(header != nextHeader) {
       debug("MPEG::Header::parse() -- The next frame was not consistent with this frame.");
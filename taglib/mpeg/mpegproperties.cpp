@@ -29,7 +29,7 @@
 #include "mpegproperties.h"
 #include "mpegfile.h"
 #include "xingheader.h"
-#include "vbriHeader.h"
+#include "vbriheader.h"
 #include "id3v2tag.h"
 #include "id3v2header.h"
 #include "apetag.h"
@@ -82,7 +82,7 @@ MPEG::Properties::Properties(File *file, ReadStyle style) :
   AudioProperties(style),
   d(new PropertiesPrivate())
 {
-  read(file);
+  read(file, style);
 }
 
 MPEG::Properties::~Properties()
@@ -125,6 +125,22 @@ const MPEG::XingHeader *MPEG::Properties::xingHeader() const
   return d->xingHeader;
 }
 
+int MPEG::Properties::encoderDelay() const
+{
+  if(d->xingHeader && d->xingHeader->hasLameTag())
+    return d->xingHeader->startPadding();
+  else
+    return 0;
+}
+
+int MPEG::Properties::encoderPadding() const
+{
+  if(d->xingHeader && d->xingHeader->hasLameTag())
+    return d->xingHeader->endPadding();
+  else
+    return 0;
+}
+
 MPEG::Header::Version MPEG::Properties::version() const
 {
   return d->version;
@@ -159,7 +175,7 @@ bool MPEG::Properties::isOriginal() const
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
-void MPEG::Properties::read(File *file)
+void MPEG::Properties::read(File *file, ReadStyle style)
 {
   // Only the first frame is required if we have a VBR header.
 
@@ -284,6 +300,9 @@ void MPEG::Properties::read(File *file)
     }
   }
     
+  if(style == Accurate)
+    readAccurately(file);
+
   d->sampleRate = validHeader.sampleRate();
   d->channels = validHeader.channelMode() == Header::SingleChannel ? 1 : 2;
   d->version = validHeader.version();
@@ -293,3 +312,17 @@ void MPEG::Properties::read(File *file)
   d->isCopyrighted = validHeader.isCopyrighted();
   d->isOriginal = validHeader.isOriginal();
 }
+
+void MPEG::Properties::readAccurately(File *file)
+{
+  // Count the samples of all the frames, rather than trusting a VBR header or
+  // assuming a constant bit rate.
+
+  const FrameIndex index = file->frameIndex(0);
+
+  if(index.sampleCount() > 0) {
+    const double length = index.sampleCount() * 1000.0 / index.sampleRate();
+    d->length  = static_cast<int>(length + 0.5);
+    d->bitrate = static_cast<int>(index.streamLength() * 8.0 / length + 0.5);
+  }
+}
@@ -44,6 +44,11 @@ namespace TagLib {
     /*!
      * This reads the data from an MPEG Layer III stream found in the
      * AudioProperties API.
+     *
+     * With the Accurate read style, the length and the bitrate are computed
+     * from all the frames of the stream, which reads the whole file.
+     * Otherwise they are taken from the Xing or VBRI header, or estimated from
+     * the stream size and the bitrate of the first frame if there is none.
      */
 
     class TAGLIB_EXPORT Properties : public AudioProperties
@@ -115,6 +120,23 @@ namespace TagLib {
       
       const VbriHeader *vbriHeader() const;
 
+      /*!
+       * Returns the number of samples of silence that the encoder added
+       * before the audio, or 0 if the file has no Lame tag.  A player drops
+       * these, as well as the delay of its decoder, for gapless playback.
+       *
+       * \see XingHeader::startPadding()
+       */
+      int encoderDelay() const;
+
+      /*!
+       * Returns the number of samples of silence that the encoder added after
+       * the audio, or 0 if the file has no Lame tag.
+       *
+       * \see XingHeader::endPadding()
+       */
+      int encoderPadding() const;
+
       /*!
        * Returns the MPEG Version of the file.
        */
@@ -149,7 +171,8 @@ namespace TagLib {
       Properties(const Properties &);
       Properties &operator=(const Properties &);
 
-      void read(File *file);
+      void read(File *file, ReadStyle style);
+      void readAccurately(File *file);
 
       class PropertiesPrivate;
       PropertiesPrivate *d;
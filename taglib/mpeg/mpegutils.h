@@ -54,6 +54,91 @@ namespace TagLib
         return (b1 == 0xFF && b2 != 0xFF && (b2 & 0xE0) == 0xE0);
       }
 
+      /*!
+       * The bit rates in kb/s by version (1, or 2 and 2.5), layer and the
+       * bitrate index of the frame header.
+       */
+      const int frameBitrates[2][3][16] = {
+        { // Version 1
+          { 0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448, 0 }, // layer 1
+          { 0, 32, 48, 56, 64,  80,  96,  112, 128, 160, 192, 224, 256, 320, 384, 0 }, // layer 2
+          { 0, 32, 40, 48, 56,  64,  80,  96,  112, 128, 160, 192, 224, 256, 320, 0 }  // layer 3
+        },
+        { // Version 2 or 2.5
+          { 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256, 0 }, // layer 1
+          { 0, 8,  16, 24, 32, 40, 48, 56,  64,  80,  96,  112, 128, 144, 160, 0 }, // layer 2
+          { 0, 8,  16, 24, 32, 40, 48, 56,  64,  80,  96,  112, 128, 144, 160, 0 }  // layer 3
+        }
+      };
+
+      /*!
+       * The sample rates by version (1, 2 and 2.5) and the sample rate index of
+       * the frame header.
+       */
+      const int frameSampleRates[3][4] = {
+        { 44100, 48000, 32000, 0 }, // Version 1
+        { 22050, 24000, 16000, 0 }, // Version 2
+        { 11025, 12000, 8000,  0 }  // Version 2.5
+      };
+
+      /*!
+       * The samples per frame by layer and version (1, or 2 and 2.5).
+       */
+      const int frameSamples[3][2] = {
+        // MPEG1, 2/2.5
+        {  384,   384 }, // Layer I
+        { 1152,  1152 }, // Layer II
+        { 1152,   576 }  // Layer III
+      };
+
+      /*!
+       * The size of the padding slot by layer.
+       */
+      const int framePaddingSizes[3] = { 4, 1, 1 };
+
+      /*!
+       * The bits of a frame header that are the same in all the frames of a
+       * stream: the synch, version, layer and sample rate.
+       */
+      const unsigned int FrameHeaderMask = 0xfffe0c00;
+
+      /*!
+       * Returns the length in bytes of the frame that starts with the four
+       * bytes \a header, most significant byte first, and sets \a samples to
+       * the number of samples in it.  Returns 0 if \a header is not a valid
+       * frame header.
+       *
+       * This is the part of Header::parse() that is needed to step from one
+       * frame to the next, without reading the file or allocating anything.
+       */
+      inline int frameLength(unsigned int header, int &samples)
+      {
+        if((header & 0xffe00000) != 0xffe00000 || (header & 0x00ff0000) == 0x00ff0000)
+          return 0;
+
+        const unsigned int versionBits = (header >> 19) & 0x03;
+        const unsigned int layerBits   = (header >> 17) & 0x03;
+        if(versionBits == 1 || layerBits == 0)
+          return 0;
+
+        const int version      = (versionBits == 3) ? 0 : (versionBits == 2) ? 1 : 2;
+        const int versionIndex = (version == 0) ? 0 : 1;
+        const int layerIndex   = 3 - layerBits;
+
+        const int bitrate    = frameBitrates[versionIndex][layerIndex][(header >> 12) & 0x0f];
+        const int sampleRate = frameSampleRates[version][(header >> 10) & 0x03];
+        if(bitrate == 0 || sampleRate == 0)
+          return 0;
+
+        samples = frameSamples[layerIndex][versionIndex];
+
+        int length = samples * bitrate * 125 / sampleRate;
+        if(header & 0x200)
+          length += framePaddingSizes[layerIndex];
+
+        return length;
+      }
+
     }
   }
 }
@@ -38,22 +38,81 @@ public:
   XingHeaderPrivate() :
     frames(0),
     size(0),
-	startPadding(0),
-	endPadding(0),
-	hasLameTag(false),
-    type(MPEG::XingHeader::Invalid) {}
+    quality(-1),
+    type(MPEG::XingHeader::Invalid),
+    hasLameTag(false),
+    startPadding(0),
+    endPadding(0),
+    lowpassFilter(0),
+    peakSignalAmplitude(0.0f),
+    hasTrackGain(false),
+    trackGain(0.0f),
+    hasAlbumGain(false),
+    albumGain(0.0f),
+    musicLength(0),
+    musicCRC(0) {}
 
   unsigned int frames;
   unsigned int size;
-  
-  uint startPadding;
-  uint endPadding;
+  ByteVector tableOfContents;
+  int quality;
 
   MPEG::XingHeader::HeaderType type;
-  
+
   bool hasLameTag;
+  String encoderVersion;
+  uint startPadding;
+  uint endPadding;
+  int lowpassFilter;
+  float peakSignalAmplitude;
+  bool hasTrackGain;
+  float trackGain;
+  bool hasAlbumGain;
+  float albumGain;
+  unsigned int musicLength;
+  unsigned short musicCRC;
 };
 
+namespace
+{
+  // The fields of a Xing header that are present if the corresponding flag
+  // is set.
+
+  enum XingFlags {
+    FramesFlag  = 0x01,
+    BytesFlag   = 0x02,
+    TocFlag     = 0x04,
+    QualityFlag = 0x08
+  };
+
+  // The LAME tag follows the Xing header and is written by LAME and by
+  // FFmpeg, which use the same layout.
+
+  const unsigned int LameTagSize = 36;
+
+  bool isLameTag(const ByteVector &data, unsigned int offset)
+  {
+    return data.containsAt("LAME", offset) ||
+           data.containsAt("Lavf", offset) ||
+           data.containsAt("Lavc", offset);
+  }
+
+  // Decodes a ReplayGain field of the LAME tag into \a gain in dB.  The top
+  // three bits name the gain, which is 0 if it is not set.
+
+  bool decodeGain(unsigned short field, float &gain)
+  {
+    if((field >> 13) == 0)
+      return false;
+
+    gain = (field & 0x1ff) / 10.0f;
+    if(field & 0x200)
+      gain = -gain;
+
+    return true;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // public members
 ////////////////////////////////////////////////////////////////////////////////
@@ -110,6 +169,61 @@ TagLib::uint MPEG::XingHeader::endPadding() const
   return d->endPadding;
 }
 
+ByteVector MPEG::XingHeader::tableOfContents() const
+{
+  return d->tableOfContents;
+}
+
+int MPEG::XingHeader::quality() const
+{
+  return d->quality;
+}
+
+String MPEG::XingHeader::encoderVersion() const
+{
+  return d->encoderVersion;
+}
+
+int MPEG::XingHeader::lowpassFilter() const
+{
+  return d->lowpassFilter;
+}
+
+float MPEG::XingHeader::peakSignalAmplitude() const
+{
+  return d->peakSignalAmplitude;
+}
+
+bool MPEG::XingHeader::hasTrackGain() const
+{
+  return d->hasTrackGain;
+}
+
+float MPEG::XingHeader::trackGain() const
+{
+  return d->trackGain;
+}
+
+bool MPEG::XingHeader::hasAlbumGain() const
+{
+  return d->hasAlbumGain;
+}
+
+float MPEG::XingHeader::albumGain() const
+{
+  return d->albumGain;
+}
+
+unsigned int MPEG::XingHeader::musicLength() const
+{
+  return d->musicLength;
+}
+
+unsigned short MPEG::XingHeader::musicCRC() const
+{
+  return d->musicCRC;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // private members
 ////////////////////////////////////////////////////////////////////////////////
@@ -126,36 +240,76 @@ void MPEG::XingHeader::parse(const ByteVector &data)
 
     // Xing header found.
 
-    if(data.size() < static_cast<unsigned long>(offset + 16)) {
+    if(data.size() < static_cast<unsigned long>(offset + 8)) {
+      debug("MPEG::XingHeader::parse() -- Xing header found but too short.");
+      return;
+    }
+
+    // The fields that are present follow the flags in this order.
+
+    const unsigned char flags = data[offset + 7];
+
+    unsigned int size = 8;
+    if(flags & FramesFlag)
+      size += 4;
+    if(flags & BytesFlag)
+      size += 4;
+    if(flags & TocFlag)
+      size += 100;
+    if(flags & QualityFlag)
+      size += 4;
+
+    if(data.size() < static_cast<unsigned long>(offset + size)) {
       debug("MPEG::XingHeader::parse() -- Xing header found but too short.");
       return;
     }
 
-    if((data[offset + 7] & 0x03) != 0x03) {
+    if((flags & (FramesFlag | BytesFlag)) != (FramesFlag | BytesFlag)) {
       debug("MPEG::XingHeader::parse() -- Xing header doesn't contain the required information.");
       return;
     }
 
-    d->frames = data.toUInt(offset + 8,  true);
-    d->size   = data.toUInt(offset + 12, true);
-    d->type   = Xing;
-    
-    // Look for LAME tag
-    if((data.size() >= (offset + 143)) && data.containsAt("LAME", offset + 120)) {
-      unsigned char b1 = data[offset + 141];
-      unsigned char b2 = data[offset + 142];
-      unsigned char b3 = data[offset + 143];
-      
-      unsigned short first = (unsigned short)(b1 << 4);
-      first += b2 >> 4;
-      
-      unsigned short second = (unsigned short)((b2 & 0xF) << 8);
-      second += b3;
-      
-      d->startPadding = first;
-      d->endPadding = second;
-      
+    unsigned int pos = offset + 8;
+
+    d->frames = data.toUInt(pos, true);
+    pos += 4;
+
+    d->size = data.toUInt(pos, true);
+    pos += 4;
+
+    if(flags & TocFlag) {
+      d->tableOfContents = data.mid(pos, 100);
+      pos += 100;
+    }
+
+    if(flags & QualityFlag) {
+      d->quality = static_cast<int>(data.toUInt(pos, true));
+      pos += 4;
+    }
+
+    d->type = Xing;
+
+    // Look for a LAME tag.
+
+    if(data.size() >= pos + LameTagSize && isLameTag(data, pos)) {
       d->hasLameTag = true;
+
+      d->encoderVersion = String(data.mid(pos, 9)).stripWhiteSpace();
+      d->lowpassFilter  = static_cast<unsigned char>(data[pos + 10]) * 100;
+
+      d->peakSignalAmplitude = data.toUInt(pos + 11, true) / static_cast<float>(1 << 23);
+
+      d->hasTrackGain = decodeGain(data.toUShort(pos + 15, true), d->trackGain);
+      d->hasAlbumGain = decodeGain(data.toUShort(pos + 17, true), d->albumGain);
+
+      // The encoder delay and padding are 12 bits each.
+
+      const unsigned int padding = data.toUInt(pos + 21, 3, true);
+      d->startPadding = padding >> 12;
+      d->endPadding   = padding & 0xfff;
+
+      d->musicLength = data.toUInt(pos + 28, true);
+      d->musicCRC    = data.toUShort(pos + 32, true);
     }
   }
   else {
@@ -28,11 +28,11 @@
 
 #include "mpegheader.h"
 #include "taglib_export.h"
+#include "tbytevector.h"
+#include "tstring.h"
 
 namespace TagLib {
 
-  class ByteVector;
-
   namespace MPEG {
 
     class File;
@@ -43,8 +43,11 @@ namespace TagLib {
      * This is a minimalistic implementation of the Xing/VBRI VBR headers.
      * Xing/VBRI headers are often added to VBR (variable bit rate) MP3 streams
      * to make it easy to compute the length and quality of a VBR stream.  Our
-     * implementation is only concerned with the total size of the stream (so
+     * implementation is mostly concerned with the total size of the stream (so
      * that we can calculate the total playing time and the average bitrate).
+     * It also reads the table of contents and the Lame tag that LAME and
+     * FFmpeg append to the Xing header, which gives the encoder delay and
+     * padding for gapless playback and the ReplayGain of the track.
      * It uses <a href="http://home.pcisys.net/~melanson/codecs/mp3extensions.txt">
      * this text</a> and the XMMS sources as references.
      */
@@ -114,21 +117,93 @@ namespace TagLib {
       static int xingHeaderOffset(TagLib::MPEG::Header::Version v,
                                   TagLib::MPEG::Header::ChannelMode c);
 
+      /*!
+       * Returns the table of contents of the Xing header, or an empty
+       * ByteVector if there is none.  Entry \e i is the position of \e i
+       * percent of the playing time in 1/256 of totalSize().
+       */
+      ByteVector tableOfContents() const;
+
+      /*!
+       * Returns the VBR quality indicator of the Xing header from 0 (best) to
+       * 100 (worst), or -1 if there is none.
+       */
+      int quality() const;
+
       /*!
        * Returns true if the Xing header contains a Lame tag.
        */
       bool hasLameTag() const;
-      
+
+      /*!
+       * Returns the encoder and its version given in the Lame tag, e.g.
+       * "LAME3.99r".
+       */
+      String encoderVersion() const;
+
       /*!
-       * Returns the size of the start padding (no. of frames) given in the Lame tag.
+       * Returns the number of samples of silence that the encoder added
+       * before the audio (the encoder delay), as given in the Lame tag.
        */
       uint startPadding() const;
-      
+
       /*!
-       * Returns the size of the end padding (no. of frames) given in the Lame tag.
+       * Returns the number of samples of silence that the encoder added
+       * after the audio, as given in the Lame tag.
        */
       uint endPadding() const;
-      
+
+      /*!
+       * Returns the cutoff frequency of the lowpass filter in Hz given in the
+       * Lame tag, or 0 if it is not known.
+       */
+      int lowpassFilter() const;
+
+      /*!
+       * Returns the peak signal amplitude given in the Lame tag, where 1.0 is
+       * full scale, or 0 if it is not known.
+       */
+      float peakSignalAmplitude() const;
+
+      /*!
+       * Returns true if the Lame tag contains a track (radio) ReplayGain.
+       */
+      bool hasTrackGain() const;
+
+      /*!
+       * Returns the track (radio) ReplayGain in dB given in the Lame tag.
+       *
+       * \see hasTrackGain()
+       */
+      float trackGain() const;
+
+      /*!
+       * Returns true if the Lame tag contains an album (audiophile)
+       * ReplayGain.
+       */
+      bool hasAlbumGain() const;
+
+      /*!
+       * Returns the album (audiophile) ReplayGain in dB given in the Lame
+       * tag.
+       *
+       * \see hasAlbumGain()
+       */
+      float albumGain() const;
+
+      /*!
+       * Returns the length in bytes of the stream from the start of the
+       * frame of this header to the end of the audio, as given in the Lame
+       * tag.
+       */
+      unsigned int musicLength() const;
+
+      /*!
+       * Returns the CRC-16 of the audio data given in the Lame tag, which
+       * covers musicLength() bytes less the frame of this header.
+       */
+      unsigned short musicCRC() const;
+
     private:
       XingHeader(const XingHeader &);
       XingHeader &operator=(const XingHeader &);
@@ -27,6 +27,7 @@
 #include <tstring.h>
 #include <tdebug.h>
 #include <tpropertymap.h>
+#include <tpropertyhandlers.h>
 
 #include <xiphcomment.h>
 #include "oggflacfile.h"
@@ -74,6 +75,8 @@ Ogg::FLAC::File::File(FileName file, bool readProperties,
   Ogg::File(file),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties, propertiesStyle);
 }
@@ -83,6 +86,8 @@ Ogg::FLAC::File::File(IOStream *stream, bool readProperties,
   Ogg::File(stream),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties, propertiesStyle);
 }
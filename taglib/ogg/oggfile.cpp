@@ -160,6 +160,8 @@ bool Ogg::File::save()
     return false;
   }
 
+  SaveScope scope(this);
+
   Map<unsigned int, ByteVector>::ConstIterator it;
   for(it = d->dirtyPackets.begin(); it != d->dirtyPackets.end(); ++it)
     writePacket(it->first, it->second);
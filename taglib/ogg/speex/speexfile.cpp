@@ -30,6 +30,7 @@
 #include <tstring.h>
 #include <tdebug.h>
 #include <tpropertymap.h>
+#include <tpropertyhandlers.h>
 
 #include "speexfile.h"
 
@@ -61,6 +62,8 @@ Speex::File::File(FileName file, bool readProperties, Properties::ReadStyle) :
   Ogg::File(file),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -69,6 +72,8 @@ Speex::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle)
   Ogg::File(stream),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -28,6 +28,7 @@
 #include <tstring.h>
 #include <tdebug.h>
 #include <tpropertymap.h>
+#include <tpropertyhandlers.h>
 
 #include "vorbisfile.h"
 
@@ -67,6 +68,8 @@ Vorbis::File::File(FileName file, bool readProperties, Properties::ReadStyle) :
   Ogg::File(file),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -75,6 +78,8 @@ Vorbis::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle)
   Ogg::File(stream),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties);
 }
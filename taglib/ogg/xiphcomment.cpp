@@ -384,8 +384,8 @@ ByteVector Ogg::XiphComment::render(bool addFramingBit) const
 
     // And now iterate over the values of the current list.
 
-    String fieldName = (*it).first;
-    StringList values = (*it).second;
+    const String &fieldName = (*it).first;
+    const StringList &values = (*it).second;
 
     StringList::ConstIterator valuesIt = values.begin();
     for(; valuesIt != values.end(); ++valuesIt) {
@@ -28,6 +28,7 @@
 #include <id3v2tag.h>
 #include <tstringlist.h>
 #include <tpropertymap.h>
+#include <tpropertyhandlers.h>
 
 #include "aifffile.h"
 
@@ -61,6 +62,8 @@ RIFF::AIFF::File::File(FileName file, bool readProperties, Properties::ReadStyle
   RIFF::File(file, BigEndian),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -69,6 +72,8 @@ RIFF::AIFF::File::File(IOStream *stream, bool readProperties, Properties::ReadSt
   RIFF::File(stream, BigEndian),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -110,6 +115,8 @@ bool RIFF::AIFF::File::save()
     return false;
   }
 
+  SaveScope scope(this);
+
   if(!isValid()) {
     debug("RIFF::AIFF::File::save() -- Trying to save invalid file.");
     return false;
@@ -27,6 +27,7 @@
 #include "tdebug.h"
 #include "tstringlist.h"
 #include "tpropertymap.h"
+#include "tpropertyhandlers.h"
 
 #include "wavfile.h"
 #include "id3v2tag.h"
@@ -68,6 +69,8 @@ RIFF::WAV::File::File(FileName file, bool readProperties, Properties::ReadStyle)
   RIFF::File(file, LittleEndian),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -76,6 +79,8 @@ RIFF::WAV::File::File(IOStream *stream, bool readProperties, Properties::ReadSty
   RIFF::File(stream, LittleEndian),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -102,6 +107,8 @@ RIFF::Info::Tag *RIFF::WAV::File::InfoTag() const
 
 void RIFF::WAV::File::strip(TagTypes tags)
 {
+  SaveScope scope(this);
+
   removeTagChunks(tags);
 
   if(tags & ID3v2)
@@ -144,6 +151,8 @@ bool RIFF::WAV::File::save(TagTypes tags, bool stripOthers, int id3v2Version)
     return false;
   }
 
+  SaveScope scope(this);
+
   if(!isValid()) {
     debug("RIFF::WAV::File::save() -- Trying to save invalid file.");
     return false;
@@ -29,6 +29,7 @@
 #include "tdebug.h"
 #include "modfileprivate.h"
 #include "tpropertymap.h"
+#include "tpropertyhandlers.h"
 
 #include <iostream>
 
@@ -52,6 +53,8 @@ S3M::File::File(FileName file, bool readProperties,
   Mod::FileBase(file),
   d(new FilePrivate(propertiesStyle))
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -61,6 +64,8 @@ S3M::File::File(IOStream *stream, bool readProperties,
   Mod::FileBase(stream),
   d(new FilePrivate(propertiesStyle))
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -96,6 +101,9 @@ bool S3M::File::save()
     debug("S3M::File::save() - Cannot save to a read only file.");
     return false;
   }
+
+  SaveScope scope(this);
+
   // note: if title starts with "Extended Module: "
   // the file would look like an .xm file
   seek(0);
@@ -8,4 +8,8 @@
 #define   TAGLIB_WITH_ASF 1
 #define   TAGLIB_WITH_MP4 1
 
+/* Defined if TagLib was built with move constructors and assignments. */
+
+#cmakedefine   TAGLIB_HAVE_RVALUE_REFERENCES 1
+
 #endif
@@ -33,47 +33,50 @@
 
 using namespace TagLib;
 
-long Utils::findID3v1(File *file)
+void Utils::findTags(File *file, long *ID3v2Location, long *ID3v1Location, long *APELocation)
 {
-  if(!file->isValid())
-    return -1;
-
-  file->seek(-128, File::End);
-  const long p = file->tell();
-
-  if(file->readBlock(3) == ID3v1::Tag::fileIdentifier())
-    return p;
-
-  return -1;
-}
+  if(ID3v2Location)
+    *ID3v2Location = -1;
+  if(ID3v1Location)
+    *ID3v1Location = -1;
+  if(APELocation)
+    *APELocation = -1;
 
-long Utils::findID3v2(File *file)
-{
   if(!file->isValid())
-    return -1;
+    return;
 
-  file->seek(0);
+  // Read the places where the identifiers of the tags may be all at once.  An
+  // APE tag ends either right before an ID3v1 tag or at the end of the file.
 
-  if(file->readBlock(3) == ID3v2::Header::fileIdentifier())
-    return 0;
+  List<IOStream::Range> ranges;
+  ranges.append(IOStream::Range(0,    3));
+  ranges.append(IOStream::Range(-128, 3));
+  ranges.append(IOStream::Range(-160, 8));
+  ranges.append(IOStream::Range(-32,  8));
 
-  return -1;
-}
+  if(!ID3v2Location)
+    ranges[0].length = 0;
 
-long Utils::findAPE(File *file, long id3v1Location)
-{
-  if(!file->isValid())
-    return -1;
+  if(!APELocation) {
+    ranges[2].length = 0;
+    ranges[3].length = 0;
+  }
+
+  const ByteVectorList blocks = file->readBlocks(ranges);
+  const long fileLength = file->length();
 
-  if(id3v1Location >= 0)
-    file->seek(id3v1Location - 32, File::Beginning);
-  else
-    file->seek(-32, File::End);
+  if(ID3v2Location && blocks[0] == ID3v2::Header::fileIdentifier())
+    *ID3v2Location = 0;
 
-  const long p = file->tell();
+  const bool hasID3v1 = (blocks[1] == ID3v1::Tag::fileIdentifier());
 
-  if(file->readBlock(8) == APE::Tag::fileIdentifier())
-    return p;
+  if(ID3v1Location && hasID3v1)
+    *ID3v1Location = fileLength - 128;
 
-  return -1;
+  if(APELocation) {
+    if(hasID3v1 && blocks[2] == APE::Tag::fileIdentifier())
+      *APELocation = fileLength - 160;
+    else if(!hasID3v1 && blocks[3] == APE::Tag::fileIdentifier())
+      *APELocation = fileLength - 32;
+  }
 }
@@ -36,11 +36,12 @@ namespace TagLib {
 
   namespace Utils {
 
-    long findID3v1(File *file);
+    // Looks for an ID3v2 tag at the beginning of the file and for ID3v1 and
+    // APE tags at its end with a single batched read.  Only the locations
+    // that are not null are looked for.  They are set to -1 if there is no
+    // such tag.
 
-    long findID3v2(File *file);
-
-    long findAPE(File *file, long id3v1Location);
+    void findTags(File *file, long *ID3v2Location, long *ID3v1Location, long *APELocation);
   }
 }
 
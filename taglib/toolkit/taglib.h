@@ -44,6 +44,15 @@
 #define TAGLIB_CONSTRUCT_BITSET(x) static_cast<unsigned long>(x)
 #endif
 
+// Move constructors and assignments are only declared if both TagLib and the
+// application are built with rvalue references, so that they always agree on
+// the exported symbols.
+
+#if defined(TAGLIB_HAVE_RVALUE_REFERENCES) && \
+    (__cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600))
+#define TAGLIB_MOVE_SEMANTICS
+#endif
+
 #include <string>
 
 //! A namespace for all TagLib related classes and functions
@@ -0,0 +1,173 @@
+/***************************************************************************
+    copyright            : (C) 2026 by the TagLib developers
+    email                :
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_ARENA_H
+#define TAGLIB_ARENA_H
+
+// THIS FILE IS NOT A PART OF THE TAGLIB API
+
+#ifndef DO_NOT_DOCUMENT  // tell Doxygen not to document this header
+
+#include <cstdlib>
+#include <new>
+
+namespace TagLib
+{
+  namespace Utils
+  {
+    /*!
+     * Allocates objects in large blocks and destroys them all at once when
+     * the arena is destroyed.  This is meant for the many small objects of a
+     * structure that is built while parsing a file and freed with it, and
+     * must not be used for objects that may be handed to the caller.
+     */
+    class Arena
+    {
+    public:
+      Arena() :
+        blocks(0),
+        finalizers(0),
+        position(0),
+        remaining(0) {}
+
+      ~Arena()
+      {
+        while(finalizers) {
+          finalizers->destroy(finalizers->object);
+          finalizers = finalizers->next;
+        }
+
+        while(blocks) {
+          Block *next = blocks->next;
+          ::free(blocks);
+          blocks = next;
+        }
+      }
+
+      /*!
+       * Returns uninitialized memory of \a size bytes that is valid until
+       * the arena is destroyed.
+       */
+      void *allocate(size_t size)
+      {
+        size = (size + Alignment - 1) / Alignment * Alignment;
+
+        if(size > remaining) {
+          const size_t blockSize = size > BlockSize / 4 ? size : BlockSize;
+          Block *block = static_cast<Block *>(::malloc(sizeof(Block) + blockSize));
+          if(!block)
+            throw std::bad_alloc();
+
+          // Large allocations get a block of their own, which is kept behind
+          // the current one so that its free space is not wasted.
+
+          if(blockSize == size && blocks) {
+            block->next = blocks->next;
+            blocks->next = block;
+            return block + 1;
+          }
+
+          block->next = blocks;
+          blocks      = block;
+          position    = reinterpret_cast<char *>(block + 1);
+          remaining   = blockSize;
+        }
+
+        void *p = position;
+        position  += size;
+        remaining -= size;
+        return p;
+      }
+
+      /*!
+       * Creates a \a T in the arena with \a arg as the argument of its
+       * constructor.  Its destructor is called when the arena is destroyed,
+       * in the reverse order of creation.
+       */
+      template <class T, class A>
+      T *create(const A &arg)
+      {
+        Finalizer *finalizer = new(allocate(sizeof(Finalizer))) Finalizer;
+        T *object = new(allocate(sizeof(T))) T(arg);
+
+        finalizer->destroy = &destroy<T>;
+        finalizer->object  = object;
+        finalizer->next    = finalizers;
+        finalizers = finalizer;
+
+        return object;
+      }
+
+      template <class T, class A1, class A2>
+      T *create(const A1 &arg1, const A2 &arg2)
+      {
+        Finalizer *finalizer = new(allocate(sizeof(Finalizer))) Finalizer;
+        T *object = new(allocate(sizeof(T))) T(arg1, arg2);
+
+        finalizer->destroy = &destroy<T>;
+        finalizer->object  = object;
+        finalizer->next    = finalizers;
+        finalizers = finalizer;
+
+        return object;
+      }
+
+    private:
+      Arena(const Arena &);
+      Arena &operator=(const Arena &);
+
+      union Block {
+        Block      *next;
+        long double alignLongDouble;
+        long long   alignLongLong;
+        void       *alignPointer;
+      };
+
+      struct Finalizer {
+        void     (*destroy)(void *);
+        void      *object;
+        Finalizer *next;
+      };
+
+      template <class T>
+      static void destroy(void *object)
+      {
+        static_cast<T *>(object)->~T();
+      }
+
+      static const size_t Alignment = sizeof(Block);
+      static const size_t BlockSize = 4096 - sizeof(Block);
+
+      Block     *blocks;
+      Finalizer *finalizers;
+      char      *position;
+      size_t     remaining;
+    };
+  }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,197 @@
+/***************************************************************************
+    copyright            : (C) 2026 by the TagLib developers
+    email                :
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_ATOMIC_H
+#define TAGLIB_ATOMIC_H
+
+// THIS FILE IS NOT A PART OF THE TAGLIB API
+
+#ifndef DO_NOT_DOCUMENT  // tell Doxygen not to document this header
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#if defined(HAVE_STD_ATOMIC)
+# include <atomic>
+# define ATOMIC_INT std::atomic_int
+# define ATOMIC_INC(x) (++x)
+# define ATOMIC_DEC(x) (--x)
+#elif defined(HAVE_GCC_ATOMIC)
+# define ATOMIC_INT int
+# define ATOMIC_INC(x) __sync_add_and_fetch(&x, 1)
+# define ATOMIC_DEC(x) __sync_sub_and_fetch(&x, 1)
+#elif defined(HAVE_WIN_ATOMIC)
+# if !defined(NOMINMAX)
+#   define NOMINMAX
+# endif
+# include <windows.h>
+# define ATOMIC_INT long
+# define ATOMIC_INC(x) InterlockedIncrement(&x)
+# define ATOMIC_DEC(x) InterlockedDecrement(&x)
+#elif defined(HAVE_MAC_ATOMIC)
+# include <libkern/OSAtomic.h>
+# define ATOMIC_INT int32_t
+# define ATOMIC_INC(x) OSAtomicIncrement32Barrier(&x)
+# define ATOMIC_DEC(x) OSAtomicDecrement32Barrier(&x)
+#elif defined(HAVE_IA64_ATOMIC)
+# include <ia64intrin.h>
+# define ATOMIC_INT int
+# define ATOMIC_INC(x) __sync_add_and_fetch(&x, 1)
+# define ATOMIC_DEC(x) __sync_sub_and_fetch(&x, 1)
+#else
+# define ATOMIC_INT int
+# define ATOMIC_INC(x) (++x)
+# define ATOMIC_DEC(x) (--x)
+#endif
+
+namespace TagLib
+{
+  namespace Utils
+  {
+    /*!
+     * A reference count that starts at one.  Unlike RefCounter it needs no
+     * allocation, so it can be a member of a private class.
+     */
+    class AtomicCounter
+    {
+    public:
+      AtomicCounter() :
+        refCount(1) {}
+
+      void ref()
+      {
+        ATOMIC_INC(refCount);
+      }
+
+      bool deref()
+      {
+        return (ATOMIC_DEC(refCount) == 0);
+      }
+
+      int count() const
+      {
+        return static_cast<int>(refCount);
+      }
+
+    private:
+      AtomicCounter(const AtomicCounter &);
+      AtomicCounter &operator=(const AtomicCounter &);
+
+      volatile ATOMIC_INT refCount;
+    };
+
+    /*!
+     * A pointer that is set at most once and can then be read from several
+     * threads.  Threads that race to set it each build their own value, and
+     * all but the one that wins delete theirs.
+     */
+    template <class T>
+    class AtomicPointer
+    {
+    public:
+      AtomicPointer() :
+        pointer(0) {}
+
+      /*!
+       * Returns the pointer, or null if it has not been set.  Everything
+       * written to the object before it was set is visible to the caller.
+       */
+      T *load() const
+      {
+#if defined(HAVE_STD_ATOMIC)
+        return pointer.load(std::memory_order_acquire);
+#elif defined(HAVE_GCC_ATOMIC) || defined(HAVE_IA64_ATOMIC)
+        T *value = pointer;
+        __sync_synchronize();
+        return value;
+#elif defined(HAVE_WIN_ATOMIC)
+        return static_cast<T *>(InterlockedCompareExchangePointer(
+          reinterpret_cast<PVOID volatile *>(const_cast<T **>(&pointer)), 0, 0));
+#elif defined(HAVE_MAC_ATOMIC)
+        T *value = pointer;
+        OSMemoryBarrier();
+        return value;
+#else
+        return pointer;
+#endif
+      }
+
+      /*!
+       * Sets the pointer to \a value if it is null.  Returns false, leaving
+       * \a value to the caller, if another thread has set it first.
+       */
+      bool testAndSet(T *value)
+      {
+#if defined(HAVE_STD_ATOMIC)
+        T *expected = 0;
+        return pointer.compare_exchange_strong(expected, value);
+#elif defined(HAVE_GCC_ATOMIC) || defined(HAVE_IA64_ATOMIC)
+        return __sync_bool_compare_and_swap(&pointer, static_cast<T *>(0), value);
+#elif defined(HAVE_WIN_ATOMIC)
+        return InterlockedCompareExchangePointer(
+          reinterpret_cast<PVOID volatile *>(&pointer), value, 0) == 0;
+#elif defined(HAVE_MAC_ATOMIC)
+        return OSAtomicCompareAndSwapPtrBarrier(
+          0, value, reinterpret_cast<void * volatile *>(&pointer));
+#else
+        if(pointer)
+          return false;
+        pointer = value;
+        return true;
+#endif
+      }
+
+      /*!
+       * Returns the pointer and sets it to null.  This must only be called
+       * while no other thread can access the object.
+       */
+      T *release()
+      {
+        T *value = load();
+#if defined(HAVE_STD_ATOMIC)
+        pointer.store(0, std::memory_order_relaxed);
+#else
+        pointer = 0;
+#endif
+        return value;
+      }
+
+    private:
+      AtomicPointer(const AtomicPointer &);
+      AtomicPointer &operator=(const AtomicPointer &);
+
+#if defined(HAVE_STD_ATOMIC)
+      std::atomic<T *> pointer;
+#else
+      T *volatile pointer;
+#endif
+    };
+  }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,241 @@
+/***************************************************************************
+    copyright            : (C) 2026 by the TagLib developers
+    email                :
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_BYTEREADER_H
+#define TAGLIB_BYTEREADER_H
+
+// THIS FILE IS NOT A PART OF THE TAGLIB API
+
+#ifndef DO_NOT_DOCUMENT  // tell Doxygen not to document this header
+
+#include <cstring>
+
+#include "tbytevector.h"
+#include "tutils.h"
+
+namespace TagLib
+{
+  namespace Utils
+  {
+    /*!
+     * A cursor for reading the fields of a binary structure from memory.
+     *
+     * Reads advance the cursor.  A read past the end returns zero or an
+     * empty vector, leaves the cursor where it was and marks the reader as
+     * failed, so that a parser can read a whole structure and check
+     * isValid() once at the end.  Nothing is allocated except by
+     * readBlock(), which shares the data of the ByteVector it was created
+     * from.
+     */
+    class ByteReader
+    {
+    public:
+      /*!
+       * Creates a reader over \a data, which must outlive the reader.
+       */
+      explicit ByteReader(const ByteVector &data) :
+        vector(&data),
+        begin(data.data()),
+        length(data.size()),
+        pos(0),
+        valid(true) {}
+
+      /*!
+       * Creates a reader over \a length bytes at \a data, which must outlive
+       * the reader.
+       */
+      ByteReader(const char *data, size_t length) :
+        vector(0),
+        begin(data),
+        length(length),
+        pos(0),
+        valid(true) {}
+
+      /*!
+       * Returns false if a read or seek has gone past the end of the data.
+       */
+      bool isValid() const
+      {
+        return valid;
+      }
+
+      size_t position() const
+      {
+        return pos;
+      }
+
+      size_t size() const
+      {
+        return length;
+      }
+
+      size_t remaining() const
+      {
+        return length - pos;
+      }
+
+      bool atEnd() const
+      {
+        return pos == length;
+      }
+
+      /*!
+       * Moves the cursor to \a position.
+       */
+      bool seek(size_t position)
+      {
+        if(position > length)
+          return fail();
+
+        pos = position;
+        return true;
+      }
+
+      /*!
+       * Moves the cursor \a count bytes forward.
+       */
+      bool skip(size_t count)
+      {
+        if(count > remaining())
+          return fail();
+
+        pos += count;
+        return true;
+      }
+
+      /*!
+       * Returns a pointer to the next \a count bytes and moves past them, or
+       * a null pointer if there are not as many left.
+       */
+      const char *read(size_t count)
+      {
+        if(count > remaining()) {
+          fail();
+          return 0;
+        }
+
+        const char *p = begin + pos;
+        pos += count;
+        return p;
+      }
+
+      /*!
+       * Returns true if the next bytes are the \a count bytes at \a s.  The
+       * cursor does not move.
+       */
+      bool startsWith(const char *s, size_t count) const
+      {
+        return count <= remaining() && ::memcmp(begin + pos, s, count) == 0;
+      }
+
+      /*!
+       * Returns the next \a count bytes.  If the reader was created from a
+       * ByteVector, they share its data.
+       */
+      ByteVector readBlock(size_t count)
+      {
+        const char *p = read(count);
+        if(!p)
+          return ByteVector();
+
+        if(vector)
+          return vector->mid(static_cast<unsigned int>(p - begin), static_cast<unsigned int>(count));
+        else
+          return ByteVector(p, static_cast<unsigned int>(count));
+      }
+
+      unsigned char readByte()
+      {
+        const char *p = read(1);
+        return p ? static_cast<unsigned char>(*p) : 0;
+      }
+
+      unsigned short readUShort(bool mostSignificantByteFirst = true)
+      {
+        return readNumber<unsigned short>(mostSignificantByteFirst);
+      }
+
+      unsigned int readUInt(bool mostSignificantByteFirst = true)
+      {
+        return readNumber<unsigned int>(mostSignificantByteFirst);
+      }
+
+      /*!
+       * Reads a 24-bit unsigned integer, e.g. the size of an ID3v2.2 frame or
+       * of a FLAC metadata block.
+       */
+      unsigned int readUInt24(bool mostSignificantByteFirst = true)
+      {
+        const unsigned char *p = reinterpret_cast<const unsigned char *>(read(3));
+        if(!p)
+          return 0;
+
+        if(mostSignificantByteFirst)
+          return (p[0] << 16) | (p[1] << 8) | p[2];
+        else
+          return (p[2] << 16) | (p[1] << 8) | p[0];
+      }
+
+      unsigned long long readULongLong(bool mostSignificantByteFirst = true)
+      {
+        return readNumber<unsigned long long>(mostSignificantByteFirst);
+      }
+
+    private:
+      template <class T>
+      T readNumber(bool mostSignificantByteFirst)
+      {
+        const char *p = read(sizeof(T));
+        if(!p)
+          return 0;
+
+        // Uses memcpy instead of reinterpret_cast to avoid an alignment exception.
+        T value;
+        ::memcpy(&value, p, sizeof(T));
+
+        if(mostSignificantByteFirst != (systemByteOrder() == BigEndian))
+          return byteSwap(value);
+        else
+          return value;
+      }
+
+      bool fail()
+      {
+        valid = false;
+        return false;
+      }
+
+      const ByteVector *vector;
+      const char *begin;
+      size_t length;
+      size_t pos;
+      bool valid;
+    };
+  }
+}
+
+#endif
+
+#endif
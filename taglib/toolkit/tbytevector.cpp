@@ -29,12 +29,14 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <utility>
 
 #include <tstring.h>
 #include <tdebug.h>
-#include <trefcounter.h>
 #include <tutils.h>
 
+#include "tatomic.h"
+
 #include "tbytevector.h"
 
 // This is a bit ugly to keep writing over and over again.
@@ -89,10 +91,8 @@ int findVector(
   if(byteAlign == 0)
     return -1;
 
-  // We don't use sophisticated algorithms like Knuth-Morris-Pratt here.
-
-  // In the current implementation of TagLib, data and patterns are too small
-  // for such algorithms to work effectively.
+  // This generic version is only used for reverse and aligned searches.
+  // Forward searches at every offset are done by findBytes().
 
   for(TIterator it = dataBegin + offset; it < dataEnd - patternSize + 1; it += byteAlign) {
 
@@ -111,6 +111,223 @@ int findVector(
   return -1;
 }
 
+namespace
+{
+// Patterns at least this long are searched with Boyer-Moore-Horspool, which
+// skips ahead by up to the length of the pattern.  Shorter ones are found
+// faster by letting memchr() look for their first byte, since that is
+// vectorized by the C library.
+
+const size_t HorspoolMinPatternSize = 16;
+
+int findBytesHorspool(
+  const char *data, size_t dataSize,
+  const char *pattern, size_t patternSize, size_t offset)
+{
+  const size_t lastIndex = patternSize - 1;
+
+  size_t skip[256];
+  std::fill(skip, skip + 256, patternSize);
+  for(size_t i = 0; i < lastIndex; ++i)
+    skip[static_cast<unsigned char>(pattern[i])] = lastIndex - i;
+
+  for(size_t pos = offset; pos + patternSize <= dataSize; ) {
+    const char last = data[pos + lastIndex];
+    if(last == pattern[lastIndex] && ::memcmp(data + pos, pattern, lastIndex) == 0)
+      return static_cast<int>(pos);
+
+    pos += skip[static_cast<unsigned char>(last)];
+  }
+
+  return -1;
+}
+
+int findBytes(
+  const char *data, size_t dataSize,
+  const char *pattern, size_t patternSize, size_t offset)
+{
+  if(patternSize == 0 || offset + patternSize > dataSize)
+    return -1;
+
+  if(patternSize >= HorspoolMinPatternSize)
+    return findBytesHorspool(data, dataSize, pattern, patternSize, offset);
+
+  const char *const begin = data + offset;
+  const char *const end   = data + dataSize - patternSize + 1;
+
+  size_t falseMatches = 0;
+
+  for(const char *it = begin; it < end; ++it) {
+    it = static_cast<const char *>(::memchr(it, pattern[0], end - it));
+    if(!it)
+      break;
+
+    if(::memcmp(it + 1, pattern + 1, patternSize - 1) == 0)
+      return static_cast<int>(it - data);
+
+    // If the first byte is too common in the data (e.g. zeros in padding),
+    // memchr() returns almost every byte and Horspool does better.
+
+    ++falseMatches;
+    if(falseMatches >= 64 && falseMatches * 16 > static_cast<size_t>(it - begin))
+      return findBytesHorspool(data, dataSize, pattern, patternSize, it - data + 1);
+  }
+
+  return -1;
+}
+
+int rfindBytes(
+  const char *data, size_t dataSize,
+  const char *pattern, size_t patternSize, size_t lastPosition)
+{
+  if(patternSize == 0 || patternSize > dataSize)
+    return -1;
+
+  lastPosition = std::min(lastPosition, dataSize - patternSize);
+
+  for(size_t pos = lastPosition + 1; pos-- > 0; ) {
+    if(data[pos] == pattern[0] && ::memcmp(data + pos + 1, pattern + 1, patternSize - 1) == 0)
+      return static_cast<int>(pos);
+  }
+
+  return -1;
+}
+
+}
+
+namespace
+{
+// The CRC-32 of Ogg pages, with the polynomial 0x04c11db7 and the most
+// significant bit first.  table[0] holds the CRC of each byte value, and
+// table[n] that of each byte value followed by n zero bytes.
+
+const unsigned int crcTable[256] = {
+  0x00000000, 0x04c11db7, 0x09823b6e, 0x0d4326d9, 0x130476dc, 0x17c56b6b,
+  0x1a864db2, 0x1e475005, 0x2608edb8, 0x22c9f00f, 0x2f8ad6d6, 0x2b4bcb61,
+  0x350c9b64, 0x31cd86d3, 0x3c8ea00a, 0x384fbdbd, 0x4c11db70, 0x48d0c6c7,
+  0x4593e01e, 0x4152fda9, 0x5f15adac, 0x5bd4b01b, 0x569796c2, 0x52568b75,
+  0x6a1936c8, 0x6ed82b7f, 0x639b0da6, 0x675a1011, 0x791d4014, 0x7ddc5da3,
+  0x709f7b7a, 0x745e66cd, 0x9823b6e0, 0x9ce2ab57, 0x91a18d8e, 0x95609039,
+  0x8b27c03c, 0x8fe6dd8b, 0x82a5fb52, 0x8664e6e5, 0xbe2b5b58, 0xbaea46ef,
+  0xb7a96036, 0xb3687d81, 0xad2f2d84, 0xa9ee3033, 0xa4ad16ea, 0xa06c0b5d,
+  0xd4326d90, 0xd0f37027, 0xddb056fe, 0xd9714b49, 0xc7361b4c, 0xc3f706fb,
+  0xceb42022, 0xca753d95, 0xf23a8028, 0xf6fb9d9f, 0xfbb8bb46, 0xff79a6f1,
+  0xe13ef6f4, 0xe5ffeb43, 0xe8bccd9a, 0xec7dd02d, 0x34867077, 0x30476dc0,
+  0x3d044b19, 0x39c556ae, 0x278206ab, 0x23431b1c, 0x2e003dc5, 0x2ac12072,
+  0x128e9dcf, 0x164f8078, 0x1b0ca6a1, 0x1fcdbb16, 0x018aeb13, 0x054bf6a4,
+  0x0808d07d, 0x0cc9cdca, 0x7897ab07, 0x7c56b6b0, 0x71159069, 0x75d48dde,
+  0x6b93dddb, 0x6f52c06c, 0x6211e6b5, 0x66d0fb02, 0x5e9f46bf, 0x5a5e5b08,
+  0x571d7dd1, 0x53dc6066, 0x4d9b3063, 0x495a2dd4, 0x44190b0d, 0x40d816ba,
+  0xaca5c697, 0xa864db20, 0xa527fdf9, 0xa1e6e04e, 0xbfa1b04b, 0xbb60adfc,
+  0xb6238b25, 0xb2e29692, 0x8aad2b2f, 0x8e6c3698, 0x832f1041, 0x87ee0df6,
+  0x99a95df3, 0x9d684044, 0x902b669d, 0x94ea7b2a, 0xe0b41de7, 0xe4750050,
+  0xe9362689, 0xedf73b3e, 0xf3b06b3b, 0xf771768c, 0xfa325055, 0xfef34de2,
+  0xc6bcf05f, 0xc27dede8, 0xcf3ecb31, 0xcbffd686, 0xd5b88683, 0xd1799b34,
+  0xdc3abded, 0xd8fba05a, 0x690ce0ee, 0x6dcdfd59, 0x608edb80, 0x644fc637,
+  0x7a089632, 0x7ec98b85, 0x738aad5c, 0x774bb0eb, 0x4f040d56, 0x4bc510e1,
+  0x46863638, 0x42472b8f, 0x5c007b8a, 0x58c1663d, 0x558240e4, 0x51435d53,
+  0x251d3b9e, 0x21dc2629, 0x2c9f00f0, 0x285e1d47, 0x36194d42, 0x32d850f5,
+  0x3f9b762c, 0x3b5a6b9b, 0x0315d626, 0x07d4cb91, 0x0a97ed48, 0x0e56f0ff,
+  0x1011a0fa, 0x14d0bd4d, 0x19939b94, 0x1d528623, 0xf12f560e, 0xf5ee4bb9,
+  0xf8ad6d60, 0xfc6c70d7, 0xe22b20d2, 0xe6ea3d65, 0xeba91bbc, 0xef68060b,
+  0xd727bbb6, 0xd3e6a601, 0xdea580d8, 0xda649d6f, 0xc423cd6a, 0xc0e2d0dd,
+  0xcda1f604, 0xc960ebb3, 0xbd3e8d7e, 0xb9ff90c9, 0xb4bcb610, 0xb07daba7,
+  0xae3afba2, 0xaafbe615, 0xa7b8c0cc, 0xa379dd7b, 0x9b3660c6, 0x9ff77d71,
+  0x92b45ba8, 0x9675461f, 0x8832161a, 0x8cf30bad, 0x81b02d74, 0x857130c3,
+  0x5d8a9099, 0x594b8d2e, 0x5408abf7, 0x50c9b640, 0x4e8ee645, 0x4a4ffbf2,
+  0x470cdd2b, 0x43cdc09c, 0x7b827d21, 0x7f436096, 0x7200464f, 0x76c15bf8,
+  0x68860bfd, 0x6c47164a, 0x61043093, 0x65c52d24, 0x119b4be9, 0x155a565e,
+  0x18197087, 0x1cd86d30, 0x029f3d35, 0x065e2082, 0x0b1d065b, 0x0fdc1bec,
+  0x3793a651, 0x3352bbe6, 0x3e119d3f, 0x3ad08088, 0x2497d08d, 0x2056cd3a,
+  0x2d15ebe3, 0x29d4f654, 0xc5a92679, 0xc1683bce, 0xcc2b1d17, 0xc8ea00a0,
+  0xd6ad50a5, 0xd26c4d12, 0xdf2f6bcb, 0xdbee767c, 0xe3a1cbc1, 0xe760d676,
+  0xea23f0af, 0xeee2ed18, 0xf0a5bd1d, 0xf464a0aa, 0xf9278673, 0xfde69bc4,
+  0x89b8fd09, 0x8d79e0be, 0x803ac667, 0x84fbdbd0, 0x9abc8bd5, 0x9e7d9662,
+  0x933eb0bb, 0x97ffad0c, 0xafb010b1, 0xab710d06, 0xa6322bdf, 0xa2f33668,
+  0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4
+};
+
+struct CRCTables
+{
+  CRCTables()
+  {
+    for(int i = 0; i < 256; ++i)
+      table[0][i] = crcTable[i];
+
+    for(int n = 1; n < 8; ++n) {
+      for(int i = 0; i < 256; ++i)
+        table[n][i] = (table[n - 1][i] << 8) ^ table[0][table[n - 1][i] >> 24];
+    }
+  }
+
+  unsigned int table[8][256];
+};
+
+const CRCTables &crcTables()
+{
+  static const CRCTables tables;
+  return tables;
+}
+}
+
+namespace
+{
+const char base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// The value of each base64 character, or 0x80 if it is not one.
+
+const unsigned char base64Decoding[256] = {
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x3e,0x80,0x80,0x80,0x3f,
+  0x34,0x35,0x36,0x37,0x38,0x39,0x3a,0x3b,0x3c,0x3d,0x80,0x80,0x80,0x80,0x80,0x80,
+  0x80,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,
+  0x0f,0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x80,0x80,0x80,0x80,0x80,
+  0x80,0x1a,0x1b,0x1c,0x1d,0x1e,0x1f,0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,0x28,
+  0x29,0x2a,0x2b,0x2c,0x2d,0x2e,0x2f,0x30,0x31,0x32,0x33,0x80,0x80,0x80,0x80,0x80,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80
+};
+
+const unsigned int Base64Invalid = 0x01000000;
+
+// decode[i] holds the bits that each character contributes to a group of
+// three bytes at position i of its group of four, or Base64Invalid.
+// encode holds the two characters for each value of 12 bits.
+
+struct Base64Tables
+{
+  Base64Tables()
+  {
+    for(int c = 0; c < 256; ++c) {
+      const unsigned int value = base64Decoding[c];
+      for(int i = 0; i < 4; ++i)
+        decode[i][c] = (value == 0x80) ? Base64Invalid : (value << (18 - i * 6));
+    }
+
+    for(int n = 0; n < 4096; ++n) {
+      encode[n][0] = base64Alphabet[n >> 6];
+      encode[n][1] = base64Alphabet[n & 0x3f];
+    }
+  }
+
+  unsigned int decode[4][256];
+  char encode[4096][2];
+};
+
+const Base64Tables &base64Tables()
+{
+  static const Base64Tables tables;
+  return tables;
+}
+}
+
 template <class T>
 T toNumber(const ByteVector &v, size_t offset, size_t length, bool mostSignificantByteFirst)
 {
@@ -252,49 +469,92 @@ long double toFloat80(const ByteVector &v, size_t offset)
     return val;
 }
 
+// The bytes of a vector are stored in its private object.  Copies of a vector
+// share the object, and vectors created by mid() share the bytes of the one
+// they were taken from by referring to its object as their parent.  This
+// needs only two allocations per vector, one for the object and one for the
+// bytes, which matters since most vectors are only a few bytes long.
+
 class ByteVector::ByteVectorPrivate
 {
 public:
   ByteVectorPrivate(unsigned int l, char c) :
-    counter(new RefCounter()),
-    data(new std::vector<char>(l, c)),
+    parent(0),
+    data(l, c),
     offset(0),
     length(l) {}
 
   ByteVectorPrivate(const char *s, unsigned int l) :
-    counter(new RefCounter()),
-    data(new std::vector<char>(s, s + l)),
+    parent(0),
+    data(s, s + l),
     offset(0),
     length(l) {}
 
-  ByteVectorPrivate(const ByteVectorPrivate &d, unsigned int o, unsigned int l) :
-    counter(d.counter),
-    data(d.data),
-    offset(d.offset + o),
+  ByteVectorPrivate(ByteVectorPrivate *d, unsigned int o, unsigned int l) :
+    parent(d->parent ? d->parent : d),
+    offset(d->offset + o),
     length(l)
   {
-    counter->ref();
+    parent->counter.ref();
   }
 
   ~ByteVectorPrivate()
   {
-    if(counter->deref()) {
-      delete counter;
-      delete data;
-    }
+    release(parent);
+  }
+
+  // Returns the data shared by all default constructed, cleared and moved
+  // from vectors, so that they need no allocations.  It is never modified,
+  // since resize() replaces it before growing the vector, and never deleted.
+
+  static ByteVectorPrivate *empty()
+  {
+    static ByteVectorPrivate e(0, '\0');
+    return &e;
+  }
+
+  static ByteVectorPrivate *share(ByteVectorPrivate *d)
+  {
+    if(d != empty())
+      d->counter.ref();
+    return d;
+  }
+
+  static void release(ByteVectorPrivate *d)
+  {
+    if(d && d != empty() && d->counter.deref())
+      delete d;
   }
 
-  RefCounter        *counter;
-  std::vector<char> *data;
-  unsigned int       offset;
-  unsigned int       length;
+  std::vector<char> &buffer()
+  {
+    return parent ? parent->data : data;
+  }
+
+  const std::vector<char> &buffer() const
+  {
+    return parent ? parent->data : data;
+  }
+
+  // True if the bytes may be modified without affecting other vectors.
+
+  bool isExclusive() const
+  {
+    return counter.count() == 1 && (!parent || parent->counter.count() == 1);
+  }
+
+  Utils::AtomicCounter counter;
+  ByteVectorPrivate   *parent;
+  std::vector<char>    data;
+  unsigned int         offset;
+  unsigned int         length;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 // static members
 ////////////////////////////////////////////////////////////////////////////////
 
-ByteVector ByteVector::null;
+ByteVector ByteVector::null(0U);
 
 ByteVector ByteVector::fromCString(const char *s, unsigned int length)
 {
@@ -344,7 +604,7 @@ ByteVector ByteVector::fromFloat64BE(double value)
 ////////////////////////////////////////////////////////////////////////////////
 
 ByteVector::ByteVector() :
-  d(new ByteVectorPrivate(0, '\0'))
+  d(ByteVectorPrivate::empty())
 {
 }
 
@@ -354,12 +614,22 @@ ByteVector::ByteVector(unsigned int size, char value) :
 }
 
 ByteVector::ByteVector(const ByteVector &v) :
-  d(new ByteVectorPrivate(*v.d, 0, v.d->length))
+  d(v.d->length > 0 ? ByteVectorPrivate::share(v.d) : ByteVectorPrivate::empty())
+{
+}
+
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+ByteVector::ByteVector(ByteVector &&v) :
+  d(v.d)
 {
+  v.d = ByteVectorPrivate::empty();
 }
 
+#endif
+
 ByteVector::ByteVector(const ByteVector &v, unsigned int offset, unsigned int length) :
-  d(new ByteVectorPrivate(*v.d, offset, length))
+  d(length > 0 ? new ByteVectorPrivate(v.d, offset, length) : ByteVectorPrivate::empty())
 {
 }
 
@@ -380,7 +650,7 @@ ByteVector::ByteVector(const char *data) :
 
 ByteVector::~ByteVector()
 {
-  delete d;
+  ByteVectorPrivate::release(d);
 }
 
 ByteVector &ByteVector::setData(const char *s, unsigned int length)
@@ -398,12 +668,12 @@ ByteVector &ByteVector::setData(const char *data)
 char *ByteVector::data()
 {
   detach();
-  return (size() > 0) ? (&(*d->data)[d->offset]) : 0;
+  return (size() > 0) ? (&d->buffer()[d->offset]) : 0;
 }
 
 const char *ByteVector::data() const
 {
-  return (size() > 0) ? (&(*d->data)[d->offset]) : 0;
+  return (size() > 0) ? (&d->buffer()[d->offset]) : 0;
 }
 
 ByteVector ByteVector::mid(unsigned int index, unsigned int length) const
@@ -416,22 +686,33 @@ ByteVector ByteVector::mid(unsigned int index, unsigned int length) const
 
 char ByteVector::at(unsigned int index) const
 {
-  return (index < size()) ? (*d->data)[d->offset + index] : 0;
+  return (index < size()) ? d->buffer()[d->offset + index] : 0;
 }
 
 int ByteVector::find(const ByteVector &pattern, unsigned int offset, int byteAlign) const
 {
+  if(byteAlign == 1)
+    return findBytes(data(), size(), pattern.data(), pattern.size(), offset);
+
   return findVector<ConstIterator>(
     begin(), end(), pattern.begin(), pattern.end(), offset, byteAlign);
 }
 
 int ByteVector::find(char c, unsigned int offset, int byteAlign) const
 {
+  if(byteAlign == 1)
+    return findBytes(data(), size(), &c, 1, offset);
+
   return findChar<ConstIterator>(begin(), end(), c, offset, byteAlign);
 }
 
 int ByteVector::rfind(const ByteVector &pattern, unsigned int offset, int byteAlign) const
 {
+  if(byteAlign == 1) {
+    const size_t lastPosition = (offset > 0) ? offset : size();
+    return rfindBytes(data(), size(), pattern.data(), pattern.size(), lastPosition);
+  }
+
   if(offset > 0) {
     offset = size() - offset - pattern.size();
     if(offset >= size())
@@ -577,6 +858,18 @@ ByteVector &ByteVector::append(const ByteVector &v)
   return *this;
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+ByteVector &ByteVector::append(ByteVector &&v)
+{
+  if(isEmpty())
+    return *this = std::move(v);
+  else
+    return append(v);
+}
+
+#endif
+
 ByteVector &ByteVector::append(char c)
 {
   resize(size() + 1, c);
@@ -597,14 +890,19 @@ unsigned int ByteVector::size() const
 ByteVector &ByteVector::resize(unsigned int size, char padding)
 {
   if(size != d->length) {
+    if(d->length == 0) {
+      ByteVector(size, padding).swap(*this);
+      return *this;
+    }
+
     detach();
 
     // Remove the excessive length of the internal buffer first to pad correctly.
     // This doesn't reallocate the buffer, since std::vector::resize() doesn't
     // reallocate the buffer when shrinking.
 
-    d->data->resize(d->offset + d->length);
-    d->data->resize(d->offset + size, padding);
+    d->buffer().resize(d->offset + d->length);
+    d->buffer().resize(d->offset + size, padding);
 
     d->length = size;
   }
@@ -615,50 +913,50 @@ ByteVector &ByteVector::resize(unsigned int size, char padding)
 ByteVector::Iterator ByteVector::begin()
 {
   detach();
-  return d->data->begin() + d->offset;
+  return d->buffer().begin() + d->offset;
 }
 
 ByteVector::ConstIterator ByteVector::begin() const
 {
-  return d->data->begin() + d->offset;
+  return d->buffer().begin() + d->offset;
 }
 
 ByteVector::Iterator ByteVector::end()
 {
   detach();
-  return d->data->begin() + d->offset + d->length;
+  return d->buffer().begin() + d->offset + d->length;
 }
 
 ByteVector::ConstIterator ByteVector::end() const
 {
-  return d->data->begin() + d->offset + d->length;
+  return d->buffer().begin() + d->offset + d->length;
 }
 
 ByteVector::ReverseIterator ByteVector::rbegin()
 {
   detach();
-  return d->data->rbegin() + (d->data->size() - (d->offset + d->length));
+  return d->buffer().rbegin() + (d->buffer().size() - (d->offset + d->length));
 }
 
 ByteVector::ConstReverseIterator ByteVector::rbegin() const
 {
   // Workaround for the Solaris Studio 12.4 compiler.
   // We need a const reference to the data vector so we can ensure the const version of rbegin() is called.
-  const std::vector<char> &v = *d->data;
+  const std::vector<char> &v = static_cast<const ByteVectorPrivate *>(d)->buffer();
   return v.rbegin() + (v.size() - (d->offset + d->length));
 }
 
 ByteVector::ReverseIterator ByteVector::rend()
 {
   detach();
-  return d->data->rbegin() + (d->data->size() - d->offset);
+  return d->buffer().rbegin() + (d->buffer().size() - d->offset);
 }
 
 ByteVector::ConstReverseIterator ByteVector::rend() const
 {
   // Workaround for the Solaris Studio 12.4 compiler.
   // We need a const reference to the data vector so we can ensure the const version of rbegin() is called.
-  const std::vector<char> &v = *d->data;
+  const std::vector<char> &v = static_cast<const ByteVectorPrivate *>(d)->buffer();
   return v.rbegin() + (v.size() - d->offset);
 }
 
@@ -674,55 +972,28 @@ bool ByteVector::isEmpty() const
 
 unsigned int ByteVector::checksum() const
 {
-  static const unsigned int crcTable[256] = {
-    0x00000000, 0x04c11db7, 0x09823b6e, 0x0d4326d9, 0x130476dc, 0x17c56b6b,
-    0x1a864db2, 0x1e475005, 0x2608edb8, 0x22c9f00f, 0x2f8ad6d6, 0x2b4bcb61,
-    0x350c9b64, 0x31cd86d3, 0x3c8ea00a, 0x384fbdbd, 0x4c11db70, 0x48d0c6c7,
-    0x4593e01e, 0x4152fda9, 0x5f15adac, 0x5bd4b01b, 0x569796c2, 0x52568b75,
-    0x6a1936c8, 0x6ed82b7f, 0x639b0da6, 0x675a1011, 0x791d4014, 0x7ddc5da3,
-    0x709f7b7a, 0x745e66cd, 0x9823b6e0, 0x9ce2ab57, 0x91a18d8e, 0x95609039,
-    0x8b27c03c, 0x8fe6dd8b, 0x82a5fb52, 0x8664e6e5, 0xbe2b5b58, 0xbaea46ef,
-    0xb7a96036, 0xb3687d81, 0xad2f2d84, 0xa9ee3033, 0xa4ad16ea, 0xa06c0b5d,
-    0xd4326d90, 0xd0f37027, 0xddb056fe, 0xd9714b49, 0xc7361b4c, 0xc3f706fb,
-    0xceb42022, 0xca753d95, 0xf23a8028, 0xf6fb9d9f, 0xfbb8bb46, 0xff79a6f1,
-    0xe13ef6f4, 0xe5ffeb43, 0xe8bccd9a, 0xec7dd02d, 0x34867077, 0x30476dc0,
-    0x3d044b19, 0x39c556ae, 0x278206ab, 0x23431b1c, 0x2e003dc5, 0x2ac12072,
-    0x128e9dcf, 0x164f8078, 0x1b0ca6a1, 0x1fcdbb16, 0x018aeb13, 0x054bf6a4,
-    0x0808d07d, 0x0cc9cdca, 0x7897ab07, 0x7c56b6b0, 0x71159069, 0x75d48dde,
-    0x6b93dddb, 0x6f52c06c, 0x6211e6b5, 0x66d0fb02, 0x5e9f46bf, 0x5a5e5b08,
-    0x571d7dd1, 0x53dc6066, 0x4d9b3063, 0x495a2dd4, 0x44190b0d, 0x40d816ba,
-    0xaca5c697, 0xa864db20, 0xa527fdf9, 0xa1e6e04e, 0xbfa1b04b, 0xbb60adfc,
-    0xb6238b25, 0xb2e29692, 0x8aad2b2f, 0x8e6c3698, 0x832f1041, 0x87ee0df6,
-    0x99a95df3, 0x9d684044, 0x902b669d, 0x94ea7b2a, 0xe0b41de7, 0xe4750050,
-    0xe9362689, 0xedf73b3e, 0xf3b06b3b, 0xf771768c, 0xfa325055, 0xfef34de2,
-    0xc6bcf05f, 0xc27dede8, 0xcf3ecb31, 0xcbffd686, 0xd5b88683, 0xd1799b34,
-    0xdc3abded, 0xd8fba05a, 0x690ce0ee, 0x6dcdfd59, 0x608edb80, 0x644fc637,
-    0x7a089632, 0x7ec98b85, 0x738aad5c, 0x774bb0eb, 0x4f040d56, 0x4bc510e1,
-    0x46863638, 0x42472b8f, 0x5c007b8a, 0x58c1663d, 0x558240e4, 0x51435d53,
-    0x251d3b9e, 0x21dc2629, 0x2c9f00f0, 0x285e1d47, 0x36194d42, 0x32d850f5,
-    0x3f9b762c, 0x3b5a6b9b, 0x0315d626, 0x07d4cb91, 0x0a97ed48, 0x0e56f0ff,
-    0x1011a0fa, 0x14d0bd4d, 0x19939b94, 0x1d528623, 0xf12f560e, 0xf5ee4bb9,
-    0xf8ad6d60, 0xfc6c70d7, 0xe22b20d2, 0xe6ea3d65, 0xeba91bbc, 0xef68060b,
-    0xd727bbb6, 0xd3e6a601, 0xdea580d8, 0xda649d6f, 0xc423cd6a, 0xc0e2d0dd,
-    0xcda1f604, 0xc960ebb3, 0xbd3e8d7e, 0xb9ff90c9, 0xb4bcb610, 0xb07daba7,
-    0xae3afba2, 0xaafbe615, 0xa7b8c0cc, 0xa379dd7b, 0x9b3660c6, 0x9ff77d71,
-    0x92b45ba8, 0x9675461f, 0x8832161a, 0x8cf30bad, 0x81b02d74, 0x857130c3,
-    0x5d8a9099, 0x594b8d2e, 0x5408abf7, 0x50c9b640, 0x4e8ee645, 0x4a4ffbf2,
-    0x470cdd2b, 0x43cdc09c, 0x7b827d21, 0x7f436096, 0x7200464f, 0x76c15bf8,
-    0x68860bfd, 0x6c47164a, 0x61043093, 0x65c52d24, 0x119b4be9, 0x155a565e,
-    0x18197087, 0x1cd86d30, 0x029f3d35, 0x065e2082, 0x0b1d065b, 0x0fdc1bec,
-    0x3793a651, 0x3352bbe6, 0x3e119d3f, 0x3ad08088, 0x2497d08d, 0x2056cd3a,
-    0x2d15ebe3, 0x29d4f654, 0xc5a92679, 0xc1683bce, 0xcc2b1d17, 0xc8ea00a0,
-    0xd6ad50a5, 0xd26c4d12, 0xdf2f6bcb, 0xdbee767c, 0xe3a1cbc1, 0xe760d676,
-    0xea23f0af, 0xeee2ed18, 0xf0a5bd1d, 0xf464a0aa, 0xf9278673, 0xfde69bc4,
-    0x89b8fd09, 0x8d79e0be, 0x803ac667, 0x84fbdbd0, 0x9abc8bd5, 0x9e7d9662,
-    0x933eb0bb, 0x97ffad0c, 0xafb010b1, 0xab710d06, 0xa6322bdf, 0xa2f33668,
-    0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4
-  };
+  const unsigned char *p = reinterpret_cast<const unsigned char *>(data());
+  size_t length = size();
+
+  const CRCTables &tables = crcTables();
+  const unsigned int (*t)[256] = tables.table;
 
   unsigned int sum = 0;
-  for(ByteVector::ConstIterator it = begin(); it != end(); ++it)
-    sum = (sum << 8) ^ crcTable[((sum >> 24) & 0xff) ^ static_cast<unsigned char>(*it)];
+
+  // Slicing-by-8: a block of eight bytes is folded into the sum with one
+  // lookup per byte in tables that combine the byte with the following
+  // zero bytes.
+
+  for(; length >= 8; p += 8, length -= 8) {
+    sum ^= (static_cast<unsigned int>(p[0]) << 24) | (static_cast<unsigned int>(p[1]) << 16)
+         | (static_cast<unsigned int>(p[2]) << 8)  |  static_cast<unsigned int>(p[3]);
+    sum = t[7][sum >> 24] ^ t[6][(sum >> 16) & 0xff] ^ t[5][(sum >> 8) & 0xff] ^ t[4][sum & 0xff]
+        ^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+  }
+
+  for(; length > 0; ++p, --length)
+    sum = (sum << 8) ^ t[0][((sum >> 24) & 0xff) ^ *p];
+
   return sum;
 }
 
@@ -803,13 +1074,13 @@ long double ByteVector::toFloat80BE(size_t offset) const
 
 const char &ByteVector::operator[](int index) const
 {
-  return (*d->data)[d->offset + index];
+  return d->buffer()[d->offset + index];
 }
 
 char &ByteVector::operator[](int index)
 {
   detach();
-  return (*d->data)[d->offset + index];
+  return d->buffer()[d->offset + index];
 }
 
 bool ByteVector::operator==(const ByteVector &v) const
@@ -865,6 +1136,16 @@ ByteVector &ByteVector::operator=(const ByteVector &v)
   return *this;
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+ByteVector &ByteVector::operator=(ByteVector &&v)
+{
+  ByteVector(std::move(v)).swap(*this);
+  return *this;
+}
+
+#endif
+
 ByteVector &ByteVector::operator=(char c)
 {
   ByteVector(c).swap(*this);
@@ -902,24 +1183,8 @@ ByteVector ByteVector::toHex() const
 
 ByteVector ByteVector::fromBase64(const ByteVector & input)
 {
-  static const unsigned char base64[256] = {
-    0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
-    0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
-    0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x3e,0x80,0x80,0x80,0x3f,
-    0x34,0x35,0x36,0x37,0x38,0x39,0x3a,0x3b,0x3c,0x3d,0x80,0x80,0x80,0x80,0x80,0x80,
-    0x80,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,
-    0x0f,0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x80,0x80,0x80,0x80,0x80,
-    0x80,0x1a,0x1b,0x1c,0x1d,0x1e,0x1f,0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,0x28,
-    0x29,0x2a,0x2b,0x2c,0x2d,0x2e,0x2f,0x30,0x31,0x32,0x33,0x80,0x80,0x80,0x80,0x80,
-    0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
-    0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
-    0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
-    0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
-    0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
-    0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
-    0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
-    0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80
-  };
+  const Base64Tables &tables = base64Tables();
+  const unsigned char *base64 = base64Decoding;
 
   unsigned int len = input.size();
 
@@ -928,6 +1193,25 @@ ByteVector ByteVector::fromBase64(const ByteVector & input)
   const unsigned char * src = (const unsigned char*) input.data();
   unsigned char *       dst = (unsigned char*) output.data();
 
+  // Decode all but the last group of four characters with one lookup per
+  // character, as they can not contain padding.  Any group with an invalid
+  // character or padding is left to the loop below, which handles it as
+  // before.
+
+  while(4 < len) {
+    const unsigned int n = tables.decode[0][src[0]] | tables.decode[1][src[1]]
+                         | tables.decode[2][src[2]] | tables.decode[3][src[3]];
+    if(n & Base64Invalid)
+      break;
+
+    dst[0] = static_cast<unsigned char>(n >> 16);
+    dst[1] = static_cast<unsigned char>(n >> 8);
+    dst[2] = static_cast<unsigned char>(n);
+    dst += 3;
+    src += 4;
+    len -= 4;
+  }
+
   while(4 <= len) {
 
     // Check invalid character
@@ -984,18 +1268,26 @@ ByteVector ByteVector::fromBase64(const ByteVector & input)
 
 ByteVector ByteVector::toBase64() const
 {
-  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  const char *alphabet = base64Alphabet;
   if(!isEmpty()) {
     unsigned int len = size();
     ByteVector output(4 * ((len - 1) / 3 + 1)); // note roundup
 
+    const Base64Tables &tables = base64Tables();
+
     const char * src = data();
     char * dst = output.data();
+
+    // Each group of three bytes is encoded as two halves of 12 bits, which
+    // are looked up as pairs of characters.
+
     while(3 <= len) {
-      *dst++ = alphabet[(src[0] >> 2) & 0x3f];
-      *dst++ = alphabet[((src[0] & 0x03) << 4) | ((src[1] >> 4) & 0x0f)];
-      *dst++ = alphabet[((src[1] & 0x0f) << 2) | ((src[2] >> 6) & 0x03)];
-      *dst++ = alphabet[src[2] & 0x3f];
+      const unsigned int n = (static_cast<unsigned int>(static_cast<unsigned char>(src[0])) << 16)
+                           | (static_cast<unsigned int>(static_cast<unsigned char>(src[1])) << 8)
+                           |  static_cast<unsigned int>(static_cast<unsigned char>(src[2]));
+      ::memcpy(dst,     tables.encode[n >> 12],   2);
+      ::memcpy(dst + 2, tables.encode[n & 0xfff], 2);
+      dst += 4;
       src += 3;
       len -= 3;
     }
@@ -1023,9 +1315,9 @@ ByteVector ByteVector::toBase64() const
 
 void ByteVector::detach()
 {
-  if(d->counter->count() > 1) {
+  if(!d->isExclusive()) {
     if(!isEmpty())
-      ByteVector(&d->data->front() + d->offset, d->length).swap(*this);
+      ByteVector(&d->buffer().front() + d->offset, d->length).swap(*this);
     else
       ByteVector().swap(*this);
   }
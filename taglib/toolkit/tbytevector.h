@@ -68,6 +68,14 @@ namespace TagLib {
      */
     ByteVector(const ByteVector &v);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Constructs a byte vector that takes over the data of \a v.  \a v is left
+     * empty.
+     */
+    ByteVector(ByteVector &&v);
+#endif
+
     /*!
      * Constructs a byte vector that is a copy of \a v.
      */
@@ -208,6 +216,14 @@ namespace TagLib {
      */
     ByteVector &append(const ByteVector &v);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Appends \a v to the end of the ByteVector.  If this vector is empty, it
+     * takes over the data of \a v instead of copying it.
+     */
+    ByteVector &append(ByteVector &&v);
+#endif
+
     /*!
      * Appends \a c to the end of the ByteVector.
      */
@@ -568,6 +584,13 @@ namespace TagLib {
      */
     ByteVector &operator=(const ByteVector &v);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Takes over the data of \a v.  \a v is left empty.
+     */
+    ByteVector &operator=(ByteVector &&v);
+#endif
+
     /*!
      * Copies a byte \a c.
      */
@@ -23,6 +23,8 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#include <algorithm>
+
 #include "tfile.h"
 #include "tfilestream.h"
 #include "tstring.h"
@@ -44,35 +46,28 @@
 # define W_OK 2
 #endif
 
-#include "asffile.h"
-#include "mpegfile.h"
-#include "vorbisfile.h"
-#include "flacfile.h"
-#include "oggflacfile.h"
-#include "mpcfile.h"
-#include "mp4file.h"
-#include "wavpackfile.h"
-#include "speexfile.h"
-#include "opusfile.h"
-#include "trueaudiofile.h"
-#include "aifffile.h"
-#include "wavfile.h"
-#include "apefile.h"
-#include "modfile.h"
-#include "s3mfile.h"
-#include "itfile.h"
-#include "xmfile.h"
-#include "mp4file.h"
-
 using namespace TagLib;
 
+namespace
+{
+  unsigned int fileBufferSize = 1024;
+
+  // rfind() doubles the size of the blocks it reads backwards up to this
+  // size, so that a match near the end of the file costs one small read and
+  // a long scan takes few large ones.
+
+  const long MaxReverseBufferSize = 64 * 1024;
+}
+
 class File::FilePrivate
 {
 public:
   FilePrivate(IOStream *stream, bool owner) :
     stream(stream),
     streamOwner(owner),
-    valid(true) {}
+    valid(true),
+    propertyHandlers(0),
+    saveDepth(0) {}
 
   ~FilePrivate()
   {
@@ -83,6 +78,8 @@ public:
   IOStream *stream;
   bool streamOwner;
   bool valid;
+  const PropertyHandlers *propertyHandlers;
+  int saveDepth;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -111,116 +108,42 @@ FileName File::name() const
 
 PropertyMap File::properties() const
 {
-  // ugly workaround until this method is virtual
-  if(dynamic_cast<const APE::File* >(this))
-    return dynamic_cast<const APE::File* >(this)->properties();
-  if(dynamic_cast<const FLAC::File* >(this))
-    return dynamic_cast<const FLAC::File* >(this)->properties();
-  if(dynamic_cast<const IT::File* >(this))
-    return dynamic_cast<const IT::File* >(this)->properties();
-  if(dynamic_cast<const Mod::File* >(this))
-    return dynamic_cast<const Mod::File* >(this)->properties();
-  if(dynamic_cast<const MPC::File* >(this))
-    return dynamic_cast<const MPC::File* >(this)->properties();
-  if(dynamic_cast<const MPEG::File* >(this))
-    return dynamic_cast<const MPEG::File* >(this)->properties();
-  if(dynamic_cast<const Ogg::FLAC::File* >(this))
-    return dynamic_cast<const Ogg::FLAC::File* >(this)->properties();
-  if(dynamic_cast<const Ogg::Speex::File* >(this))
-    return dynamic_cast<const Ogg::Speex::File* >(this)->properties();
-  if(dynamic_cast<const Ogg::Opus::File* >(this))
-    return dynamic_cast<const Ogg::Opus::File* >(this)->properties();
-  if(dynamic_cast<const Ogg::Vorbis::File* >(this))
-    return dynamic_cast<const Ogg::Vorbis::File* >(this)->properties();
-  if(dynamic_cast<const RIFF::AIFF::File* >(this))
-    return dynamic_cast<const RIFF::AIFF::File* >(this)->properties();
-  if(dynamic_cast<const RIFF::WAV::File* >(this))
-    return dynamic_cast<const RIFF::WAV::File* >(this)->properties();
-  if(dynamic_cast<const S3M::File* >(this))
-    return dynamic_cast<const S3M::File* >(this)->properties();
-  if(dynamic_cast<const TrueAudio::File* >(this))
-    return dynamic_cast<const TrueAudio::File* >(this)->properties();
-  if(dynamic_cast<const WavPack::File* >(this))
-    return dynamic_cast<const WavPack::File* >(this)->properties();
-  if(dynamic_cast<const XM::File* >(this))
-    return dynamic_cast<const XM::File* >(this)->properties();
-  if(dynamic_cast<const MP4::File* >(this))
-    return dynamic_cast<const MP4::File* >(this)->properties();
-  if(dynamic_cast<const ASF::File* >(this))
-    return dynamic_cast<const ASF::File* >(this)->properties();
+  if(d->propertyHandlers)
+    return d->propertyHandlers->properties(this);
   return tag()->properties();
 }
 
 void File::removeUnsupportedProperties(const StringList &properties)
 {
-  // here we only consider those formats that could possibly contain
-  // unsupported properties
-  if(dynamic_cast<APE::File* >(this))
-    dynamic_cast<APE::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<FLAC::File* >(this))
-    dynamic_cast<FLAC::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<MPC::File* >(this))
-    dynamic_cast<MPC::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<MPEG::File* >(this))
-    dynamic_cast<MPEG::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<Ogg::Vorbis::File* >(this))
-    dynamic_cast<Ogg::Vorbis::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<RIFF::AIFF::File* >(this))
-    dynamic_cast<RIFF::AIFF::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<RIFF::WAV::File* >(this))
-    dynamic_cast<RIFF::WAV::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<TrueAudio::File* >(this))
-    dynamic_cast<TrueAudio::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<WavPack::File* >(this))
-    dynamic_cast<WavPack::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<MP4::File* >(this))
-    dynamic_cast<MP4::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<ASF::File* >(this))
-    dynamic_cast<ASF::File* >(this)->removeUnsupportedProperties(properties);
+  if(d->propertyHandlers && d->propertyHandlers->removeUnsupportedProperties)
+    d->propertyHandlers->removeUnsupportedProperties(this, properties);
   else
     tag()->removeUnsupportedProperties(properties);
 }
 
 PropertyMap File::setProperties(const PropertyMap &properties)
 {
-  if(dynamic_cast<APE::File* >(this))
-    return dynamic_cast<APE::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<FLAC::File* >(this))
-    return dynamic_cast<FLAC::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<IT::File* >(this))
-    return dynamic_cast<IT::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<Mod::File* >(this))
-    return dynamic_cast<Mod::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<MPC::File* >(this))
-    return dynamic_cast<MPC::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<MPEG::File* >(this))
-    return dynamic_cast<MPEG::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<Ogg::FLAC::File* >(this))
-    return dynamic_cast<Ogg::FLAC::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<Ogg::Speex::File* >(this))
-    return dynamic_cast<Ogg::Speex::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<Ogg::Opus::File* >(this))
-    return dynamic_cast<Ogg::Opus::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<Ogg::Vorbis::File* >(this))
-    return dynamic_cast<Ogg::Vorbis::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<RIFF::AIFF::File* >(this))
-    return dynamic_cast<RIFF::AIFF::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<RIFF::WAV::File* >(this))
-    return dynamic_cast<RIFF::WAV::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<S3M::File* >(this))
-    return dynamic_cast<S3M::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<TrueAudio::File* >(this))
-    return dynamic_cast<TrueAudio::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<WavPack::File* >(this))
-    return dynamic_cast<WavPack::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<XM::File* >(this))
-    return dynamic_cast<XM::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<MP4::File* >(this))
-    return dynamic_cast<MP4::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<ASF::File* >(this))
-    return dynamic_cast<ASF::File* >(this)->setProperties(properties);
+  if(d->propertyHandlers)
+    return d->propertyHandlers->setProperties(this, properties);
+  return tag()->setProperties(properties);
+}
+
+void File::setSaveStrategy(SaveStrategy strategy)
+{
+  FileStream *stream = dynamic_cast<FileStream *>(d->stream);
+  if(stream)
+    stream->setReplaceFile(strategy == ReplaceFile);
+  else if(strategy != InPlace)
+    debug("File::setSaveStrategy() -- Only supported for a FileStream.");
+}
+
+File::SaveStrategy File::saveStrategy() const
+{
+  const FileStream *stream = dynamic_cast<const FileStream *>(d->stream);
+  if(stream && stream->replaceFile())
+    return ReplaceFile;
   else
-    return tag()->setProperties(properties);
+    return InPlace;
 }
 
 ByteVector File::readBlock(unsigned long length)
@@ -228,6 +151,11 @@ ByteVector File::readBlock(unsigned long length)
   return d->stream->readBlock(length);
 }
 
+ByteVectorList File::readBlocks(const List<IOStream::Range> &ranges)
+{
+  return d->stream->readBlocks(ranges);
+}
+
 void File::writeBlock(const ByteVector &data)
 {
   d->stream->writeBlock(data);
@@ -334,18 +262,6 @@ long File::rfind(const ByteVector &pattern, long fromOffset, const ByteVector &b
   if(!d->stream || pattern.size() > bufferSize())
       return -1;
 
-  // The position in the file that the current buffer starts at.
-
-  ByteVector buffer;
-
-  // These variables are used to keep track of a partial match that happens at
-  // the end of a buffer.
-
-  /*
-  int previousPartialMatch = -1;
-  int beforePreviousPartialMatch = -1;
-  */
-
   // Save the location of the current read pointer.  We will restore the
   // position using seek() before all returns.
 
@@ -356,30 +272,25 @@ long File::rfind(const ByteVector &pattern, long fromOffset, const ByteVector &b
   if(fromOffset == 0)
     fromOffset = length();
 
-  long bufferLength = bufferSize();
-  long bufferOffset = fromOffset + pattern.size();
+  // The blocks overlap by the length of the longer pattern less one byte, so
+  // that a match which straddles two blocks is wholly contained in the one
+  // that is read later.  This replaces the partial match bookkeeping of
+  // find().
 
-  // See the notes in find() for an explanation of this algorithm.
+  const long overlap = static_cast<long>(std::max(std::max(pattern.size(), before.size()), 1U)) - 1;
+
+  long bufferLength = std::max(static_cast<long>(bufferSize()), overlap + 1);
+  long bufferEnd    = fromOffset + pattern.size();
 
   while(true) {
 
-    if(bufferOffset > bufferLength) {
-      bufferOffset -= bufferLength;
-    }
-    else {
-      bufferLength = bufferOffset;
-      bufferOffset = 0;
-    }
+    const long bufferOffset = std::max(bufferEnd - bufferLength, 0L);
     seek(bufferOffset);
 
-    buffer = readBlock(bufferLength);
+    const ByteVector buffer = readBlock(bufferEnd - bufferOffset);
     if(buffer.isEmpty())
       break;
 
-    // TODO: (1) previous partial match
-
-    // (2) pattern contained in current buffer
-
     const long location = buffer.rfind(pattern);
     if(location >= 0) {
       seek(originalPosition);
@@ -391,7 +302,11 @@ long File::rfind(const ByteVector &pattern, long fromOffset, const ByteVector &b
       return -1;
     }
 
-    // TODO: (3) partial match
+    if(bufferOffset == 0)
+      break;
+
+    bufferEnd    = bufferOffset + overlap;
+    bufferLength = std::max(std::min(bufferLength * 2, MaxReverseBufferSize), bufferLength);
   }
 
   // Since we hit the end of the file, reset the status before continuing.
@@ -433,11 +348,32 @@ void File::seek(long offset, Position p)
   d->stream->seek(offset, IOStream::Position(p));
 }
 
+void File::setPropertyHandlers(const PropertyHandlers *handlers)
+{
+  d->propertyHandlers = handlers;
+}
+
 void File::truncate(long length)
 {
   d->stream->truncate(length);
 }
 
+File::SaveScope::SaveScope(File *file) :
+  file(file)
+{
+  ++file->d->saveDepth;
+}
+
+File::SaveScope::~SaveScope()
+{
+  if(--file->d->saveDepth > 0)
+    return;
+
+  FileStream *stream = dynamic_cast<FileStream *>(file->d->stream);
+  if(stream)
+    stream->commit();
+}
+
 void File::clear()
 {
   d->stream->clear();
@@ -453,6 +389,15 @@ long File::length()
   return d->stream->length();
 }
 
+long File::resizeAlignment() const
+{
+  const FileStream *stream = dynamic_cast<const FileStream *>(d->stream);
+  if(stream)
+    return stream->resizeAlignment();
+  else
+    return 0;
+}
+
 bool File::isReadable(const char *file)
 {
 
@@ -483,13 +428,19 @@ bool File::isWritable(const char *file)
 
 }
 
+void File::setBufferSize(unsigned int size) // static
+{
+  if(size > 0)
+    fileBufferSize = size;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // protected members
 ////////////////////////////////////////////////////////////////////////////////
 
 unsigned int File::bufferSize()
 {
-  return 1024;
+  return fileBufferSize;
 }
 
 void File::setValid(bool valid)
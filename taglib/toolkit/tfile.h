@@ -62,6 +62,31 @@ namespace TagLib {
       End
     };
 
+    /*!
+     * How save() writes the changes to the file.
+     */
+    enum SaveStrategy {
+      //! Modify the file itself, moving the rest of it when the tags change
+      //! size.
+      InPlace,
+      //! Write the changed file to a temporary file and rename it over the
+      //! original at the end of the save.
+      ReplaceFile
+    };
+
+    /*!
+     * The functions that implement properties(), removeUnsupportedProperties()
+     * and setProperties() for a subclass.  \a removeUnsupportedProperties may
+     * be null if the subclass does not reimplement it.
+     *
+     * \see setPropertyHandlers()
+     */
+    struct PropertyHandlers {
+      PropertyMap (*properties)(const File *file);
+      void (*removeUnsupportedProperties)(File *file, const StringList &properties);
+      PropertyMap (*setProperties)(File *file, const PropertyMap &properties);
+    };
+
     /*!
      * Destroys this File instance.
      */
@@ -135,11 +160,42 @@ namespace TagLib {
      */
     virtual bool save() = 0;
 
+    /*!
+     * Sets how save() writes the changes to the file.  The default is
+     * InPlace.
+     *
+     * With ReplaceFile, all the changes of a save() go to a copy of the file,
+     * which is synced to the disk and renamed over the original once the save
+     * is done.  So an interrupted save leaves either the old or the new file,
+     * but never a partly rewritten one.  On file systems with reflinks the
+     * audio data is shared rather than copied.  This is only supported for
+     * files opened by name or through a FileStream, and falls back to InPlace
+     * where it is not possible.
+     *
+     * \see FileStream::setReplaceFile()
+     */
+    void setSaveStrategy(SaveStrategy strategy);
+
+    /*!
+     * Returns how save() writes the file when its tags change size.
+     *
+     * \see setSaveStrategy()
+     */
+    SaveStrategy saveStrategy() const;
+
     /*!
      * Reads a block of size \a length at the current get pointer.
      */
     ByteVector readBlock(unsigned long length);
 
+    /*!
+     * Reads the blocks described by \a ranges with as few reads as possible
+     * and returns them in the same order.
+     *
+     * \see IOStream::readBlocks()
+     */
+    ByteVectorList readBlocks(const List<IOStream::Range> &ranges);
+
     /*!
      * Attempts to write the block \a data at the current get pointer.  If the
      * file is currently only opened read only -- i.e. readOnly() returns true --
@@ -161,7 +217,9 @@ namespace TagLib {
      * file.
      *
      * \note This has the practical limitation that \a pattern can not be longer
-     * than the buffer size used by readBlock().  Currently this is 1024 bytes.
+     * than the buffer size used by readBlock().  By default this is 1024 bytes.
+     *
+     * \see setBufferSize()
      */
     long find(const ByteVector &pattern,
               long fromOffset = 0,
@@ -177,7 +235,9 @@ namespace TagLib {
      * beginning of the file and defaults to the end of the file.
      *
      * \note This has the practical limitation that \a pattern can not be longer
-     * than the buffer size used by readBlock().  Currently this is 1024 bytes.
+     * than the buffer size used by readBlock().  By default this is 1024 bytes.
+     *
+     * \see setBufferSize()
      */
     long rfind(const ByteVector &pattern,
                long fromOffset = 0,
@@ -240,6 +300,14 @@ namespace TagLib {
      */
     long length();
 
+    /*!
+     * Returns the multiple of bytes by which the file can grow or shrink
+     * without moving the rest of it, or 0 if it can't.
+     *
+     * \see FileStream::resizeAlignment()
+     */
+    long resizeAlignment() const;
+
     /*!
      * Returns true if \a file can be opened for reading.  If the file does not
      * exist, this will return false.
@@ -255,6 +323,17 @@ namespace TagLib {
      */
     static bool isWritable(const char *name);
 
+    /*!
+     * Sets the size of the blocks in which find(), rfind() and the file type
+     * specific scanners read the file.  The default is 1024 bytes.  Larger
+     * blocks mean fewer reads when a pattern is far from where the search
+     * starts, e.g. on slow network file systems.
+     *
+     * \note This is a global setting and is not thread safe.  It should be set
+     * before any files are opened.
+     */
+    static void setBufferSize(unsigned int size);
+
   protected:
     /*!
      * Construct a File object and opens the \a file.  \a file should be a
@@ -283,13 +362,47 @@ namespace TagLib {
      */
     void setValid(bool valid);
 
+    /*!
+     * Makes properties(), removeUnsupportedProperties() and setProperties()
+     * call the functions in \a handlers instead of the ones of tag().
+     * Subclasses that reimplement these methods call this in their
+     * constructors.  \a handlers must outlive the file, so it is usually
+     * static.
+     *
+     * BIC: Remove when the methods are virtual.
+     */
+    void setPropertyHandlers(const PropertyHandlers *handlers);
+
     /*!
      * Truncates the file to a \a length.
      */
     void truncate(long length);
 
+    /*!
+     * Subclasses create one of these on the stack in their methods that write
+     * the tags to the file, before they modify it.  With the ReplaceFile save
+     * strategy, the changes go to a copy of the file, which replaces it when
+     * the outermost SaveScope of the file is destroyed.
+     *
+     * \see setSaveStrategy()
+     */
+    class TAGLIB_EXPORT SaveScope
+    {
+    public:
+      explicit SaveScope(File *file);
+      ~SaveScope();
+
+    private:
+      SaveScope(const SaveScope &);
+      SaveScope &operator=(const SaveScope &);
+
+      File *file;
+    };
+
     /*!
      * Returns the buffer size that is used for internal buffering.
+     *
+     * \see setBufferSize()
      */
     static unsigned int bufferSize();
 
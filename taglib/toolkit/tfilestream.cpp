@@ -23,6 +23,12 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <climits>
+
 #include "tfilestream.h"
 #include "tstring.h"
 #include "tdebug.h"
@@ -31,7 +37,13 @@
 # include <windows.h>
 #else
 # include <stdio.h>
+# include <errno.h>
+# include <fcntl.h>
 # include <unistd.h>
+# include <sys/types.h>
+# include <sys/stat.h>
+# include <string>
+# include <vector>
 #endif
 
 using namespace TagLib;
@@ -81,7 +93,102 @@ namespace
       return 0;
   }
 
-#else   // _WIN32
+  long fileSize(FileHandle file)
+  {
+    LARGE_INTEGER size;
+    if(GetFileSizeEx(file, &size) && size.QuadPart <= LONG_MAX)
+      return static_cast<long>(size.QuadPart);
+    else
+      return -1;
+  }
+
+#elif defined(HAVE_PREAD)
+
+  // Uses a raw file descriptor and pread()/pwrite() instead of stdio.  This
+  // avoids copying the data through the stdio buffer and makes a read or
+  // write a single system call without a separate lseek().
+
+  struct FileNameHandle : public std::string
+  {
+    FileNameHandle(FileName name) : std::string(name) {}
+    operator FileName () const { return c_str(); }
+  };
+
+  // A file descriptor doesn't track the position for pread()/pwrite(), so it
+  // is kept here along with it.
+
+  struct FileDescriptor
+  {
+    int fd;
+    long position;
+  };
+
+  typedef FileDescriptor *FileHandle;
+
+  const FileHandle InvalidFileHandle = 0;
+
+  FileHandle openFile(const FileName &path, bool readOnly)
+  {
+    const int fd = ::open(path, readOnly ? O_RDONLY : O_RDWR);
+    if(fd < 0)
+      return InvalidFileHandle;
+
+    FileHandle file = new FileDescriptor;
+    file->fd = fd;
+    file->position = 0;
+    return file;
+  }
+
+  void closeFile(FileHandle file)
+  {
+    ::close(file->fd);
+    delete file;
+  }
+
+  size_t readFile(FileHandle file, ByteVector &buffer)
+  {
+    size_t count = 0;
+    while(count < buffer.size()) {
+      const ssize_t n = ::pread(file->fd, buffer.data() + count, buffer.size() - count,
+                                file->position + static_cast<long>(count));
+      if(n < 0 && errno == EINTR)
+        continue;
+      if(n <= 0)
+        break;
+      count += static_cast<size_t>(n);
+    }
+
+    file->position += static_cast<long>(count);
+    return count;
+  }
+
+  size_t writeFile(FileHandle file, const ByteVector &buffer)
+  {
+    size_t count = 0;
+    while(count < buffer.size()) {
+      const ssize_t n = ::pwrite(file->fd, buffer.data() + count, buffer.size() - count,
+                                 file->position + static_cast<long>(count));
+      if(n < 0 && errno == EINTR)
+        continue;
+      if(n <= 0)
+        break;
+      count += static_cast<size_t>(n);
+    }
+
+    file->position += static_cast<long>(count);
+    return count;
+  }
+
+  long fileSize(FileHandle file)
+  {
+    struct stat st;
+    if(fstat(file->fd, &st) == 0 && st.st_size <= LONG_MAX)
+      return static_cast<long>(st.st_size);
+    else
+      return -1;
+  }
+
+#else   // HAVE_PREAD
 
   struct FileNameHandle : public std::string
   {
@@ -113,55 +220,376 @@ namespace
     return fwrite(buffer.data(), sizeof(char), buffer.size(), file);
   }
 
+  long fileSize(FileHandle file)
+  {
+    struct stat st;
+    if(fstat(fileno(file), &st) == 0 && st.st_size <= LONG_MAX)
+      return static_cast<long>(st.st_size);
+    else
+      return -1;
+  }
+
 #endif  // _WIN32
+
+#if defined(HAVE_PREAD) && defined(FALLOC_FL_INSERT_RANGE) && defined(FALLOC_FL_COLLAPSE_RANGE)
+
+  // Some file systems on Linux (e.g. ext4 and XFS) can insert or remove whole
+  // blocks in the middle of a file without moving the data after them.  The
+  // offset and the length must be multiples of the block size, and the range
+  // must end before the end of the file.
+
+  long blockSize(FileHandle file)
+  {
+    struct stat st;
+    if(fstat(file->fd, &st) == 0)
+      return static_cast<long>(st.st_blksize);
+    else
+      return 0;
+  }
+
+  bool insertRange(FileHandle file, long offset, long length)
+  {
+    return (::fallocate(file->fd, FALLOC_FL_INSERT_RANGE, offset, length) == 0);
+  }
+
+  bool collapseRange(FileHandle file, long offset, long length)
+  {
+    return (::fallocate(file->fd, FALLOC_FL_COLLAPSE_RANGE, offset, length) == 0);
+  }
+
+#else
+
+  long blockSize(FileHandle)
+  {
+    return 0;
+  }
+
+  bool insertRange(FileHandle, long, long)
+  {
+    return false;
+  }
+
+  bool collapseRange(FileHandle, long, long)
+  {
+    return false;
+  }
+
+#endif
+
+  // The default for FileStream::bufferSize().
+
+  unsigned int streamBufferSize = 1024;
+
+  // insert() and removeBlock() grow their buffer up to this size when they
+  // have to move a lot of data, so that large files are moved with a few
+  // large reads and writes.
+
+  const unsigned long MaxCopyBufferSize = 4 * 1024 * 1024;
+
+  unsigned long copyBufferSize(unsigned long minSize, unsigned long bytesToMove)
+  {
+    unsigned long size = minSize;
+    while(size < bytesToMove && size < MaxCopyBufferSize)
+      size *= 2;
+
+    return size;
+  }
+
+#ifdef HAVE_PREAD
+
+  // Copies \a length bytes at \a fromOffset in \a from to \a toOffset in \a to.
+
+  bool copyRange(int from, long fromOffset, int to, long toOffset, long length)
+  {
+#ifdef HAVE_COPY_FILE_RANGE
+
+    // The kernel copies the data without passing it through user space, or
+    // just shares the blocks on file systems with reflinks (Btrfs, XFS).
+
+    while(length > 0) {
+      loff_t in  = fromOffset;
+      loff_t out = toOffset;
+      const ssize_t n = ::copy_file_range(from, &in, to, &out, static_cast<size_t>(length), 0);
+      if(n < 0 && errno == EINTR)
+        continue;
+      if(n <= 0)
+        break;
+      fromOffset += static_cast<long>(n);
+      toOffset   += static_cast<long>(n);
+      length     -= static_cast<long>(n);
+    }
+
+    // It may not be supported by the file system, so fall back to copying
+    // the rest by ourselves.
+
+    if(length == 0)
+      return true;
+
+#endif
+
+    FileDescriptor source = { from, fromOffset };
+    FileDescriptor target = { to, toOffset };
+
+    ByteVector buffer(static_cast<unsigned int>(copyBufferSize(streamBufferSize, length)));
+
+    while(length > 0) {
+      if(static_cast<long>(buffer.size()) > length)
+        buffer.resize(static_cast<unsigned int>(length));
+
+      const size_t count = readFile(&source, buffer);
+      if(count != buffer.size() || writeFile(&target, buffer) != count)
+        return false;
+
+      length -= static_cast<long>(count);
+    }
+
+    return true;
+  }
+
+  // Returns true if the file \a name can be replaced by renaming another file
+  // over it.  That would replace a symbolic link with a regular file, and
+  // would not change the file for its other hard links.
+
+  bool canReplace(const std::string &name)
+  {
+    struct stat st;
+    return (lstat(name.c_str(), &st) == 0 && S_ISREG(st.st_mode) && st.st_nlink == 1);
+  }
+
+  // Writes the contents of \a fd with \a replace bytes at \a start replaced by
+  // \a data to a new temporary file in the same directory as \a name.  Returns
+  // its descriptor and sets \a copyName, or returns -1 if that fails.
+
+  int copyFile(int fd, const std::string &name, long size,
+               const ByteVector &data, long start, long replace, std::string &copyName)
+  {
+    struct stat st;
+    if(fstat(fd, &st) != 0)
+      return -1;
+
+    const std::string pattern = name + ".XXXXXX";
+    std::vector<char> tempName(pattern.begin(), pattern.end());
+    tempName.push_back('\0');
+
+    const int copy = ::mkstemp(&tempName[0]);
+    if(copy < 0)
+      return -1;
+
+    // Keep the permissions and, where we are allowed to, the owner.
+
+    fchmod(copy, st.st_mode & 07777);
+    if(fchown(copy, st.st_uid, st.st_gid) != 0) {
+      // Ignore; the file just belongs to us then.
+    }
+
+    FileDescriptor target = { copy, start };
+
+    const bool written
+      =  copyRange(fd, 0, copy, 0, start)
+      && writeFile(&target, data) == data.size()
+      && copyRange(fd, start + replace, copy, target.position, size - start - replace);
+
+    if(!written) {
+      ::close(copy);
+      ::unlink(&tempName[0]);
+      return -1;
+    }
+
+    copyName = &tempName[0];
+    return copy;
+  }
+
+  // Syncs the directory that contains \a name, so that a rename() in it
+  // survives a crash.
+
+  bool syncDirectory(const std::string &name)
+  {
+    const std::string::size_type slash = name.rfind('/');
+    const std::string directory
+      = (slash == std::string::npos) ? std::string(".") : name.substr(0, slash + 1);
+
+    const int fd = ::open(directory.c_str(), O_RDONLY);
+    if(fd < 0)
+      return false;
+
+    const bool synced = (fsync(fd) == 0);
+    ::close(fd);
+    return synced;
+  }
+
+#endif
 }
 
 class FileStream::FileStreamPrivate
 {
 public:
-  FileStreamPrivate(const FileName &fileName)
+  FileStreamPrivate(const FileName &fileName, unsigned int bufferSize)
     : file(InvalidFileHandle)
     , name(fileName)
     , readOnly(true)
+    , size(0)
+    , bufferSize(bufferSize)
+    , replaceFile(false)
+    , originalFile(-1)
+    , copyFailed(false)
   {
   }
 
+  void open(const FileName &fileName, bool openReadOnly);
+  bool writeToCopy(const ByteVector &data, long start, long replace);
+  bool commit();
+
   FileHandle file;
   FileNameHandle name;
   bool readOnly;
-};
 
-////////////////////////////////////////////////////////////////////////////////
-// public members
-////////////////////////////////////////////////////////////////////////////////
+  // The length of the file is cached, since querying it requires a few system
+  // calls and it is needed for every readBlock().  It is updated by all the
+  // operations that may change the length of the file.
 
-FileStream::FileStream(FileName fileName, bool openReadOnly)
-  : d(new FileStreamPrivate(fileName))
+  long size;
+
+  unsigned int bufferSize;
+  bool replaceFile;
+
+  // While the changes go to a copy of the file, the descriptor of the
+  // original file and the name of the copy.  originalFile is -1 otherwise.
+
+  int originalFile;
+  std::string copyName;
+
+  // Set if the file could not be copied, so that the changes are made in
+  // place until the next commit().
+
+  bool copyFailed;
+};
+
+void FileStream::FileStreamPrivate::open(const FileName &fileName, bool openReadOnly)
 {
   // First try with read / write mode, if that fails, fall back to read only.
 
   if(!openReadOnly)
-    d->file = openFile(fileName, false);
+    file = openFile(fileName, false);
 
-  if(d->file != InvalidFileHandle)
-    d->readOnly = false;
+  if(file != InvalidFileHandle)
+    readOnly = false;
   else
-    d->file = openFile(fileName, true);
+    file = openFile(fileName, true);
 
-  if(d->file == InvalidFileHandle)
+  if(file == InvalidFileHandle)
   {
 # ifdef _WIN32
     debug("Could not open file " + fileName.toString());
 # else
-    debug("Could not open file " + String(static_cast<const char *>(d->name)));
+    debug("Could not open file " + String(static_cast<const char *>(name)));
 # endif
+    return;
+  }
+
+  size = fileSize(file);
+  if(size < 0) {
+    debug("FileStream::FileStream() -- Failed to get the file size.");
+    size = 0;
+  }
+}
+
+// If replaceFile is set and the file has not been copied yet, writes it with
+// \a replace bytes at \a start replaced by \a data to a copy, which takes the
+// place of the file until commit().  Returns false if the change has to be
+// made in place, which after the first change means in place in the copy.
+
+bool FileStream::FileStreamPrivate::writeToCopy(const ByteVector &data, long start, long replace)
+{
+#ifdef HAVE_PREAD
+
+  if(!replaceFile || copyFailed || readOnly || originalFile >= 0)
+    return false;
+
+  const int copy = canReplace(name)
+    ? copyFile(file->fd, name, size, data, start, replace, copyName) : -1;
+
+  if(copy < 0) {
+    debug("FileStream::writeToCopy() -- Could not copy the file. Modifying it in place.");
+    copyFailed = true;
+    return false;
+  }
+
+  originalFile = file->fd;
+  file->fd = copy;
+  size += static_cast<long>(data.size()) - replace;
+
+  return true;
+
+#else
+
+  return false;
+
+#endif
+}
+
+bool FileStream::FileStreamPrivate::commit()
+{
+  copyFailed = false;
+
+#ifdef HAVE_PREAD
+
+  if(originalFile < 0)
+    return true;
+
+  const bool replaced
+    = (fsync(file->fd) == 0 && ::rename(copyName.c_str(), name.c_str()) == 0);
+
+  if(replaced) {
+    if(!syncDirectory(name))
+      debug("FileStream::commit() -- Could not sync the directory.");
+
+    ::close(originalFile);
+  }
+  else {
+    debug("FileStream::commit() -- Could not replace the file. Writing it in place.");
+
+    if(!copyRange(file->fd, 0, originalFile, 0, size) || ftruncate(originalFile, size) != 0)
+      debug("FileStream::commit() -- Could not write the file.");
+
+    ::close(file->fd);
+    ::unlink(copyName.c_str());
+    file->fd = originalFile;
   }
+
+  originalFile = -1;
+  copyName.clear();
+
+  return replaced;
+
+#else
+
+  return true;
+
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+FileStream::FileStream(FileName fileName, bool openReadOnly)
+  : d(new FileStreamPrivate(fileName, bufferSize()))
+{
+  d->open(fileName, openReadOnly);
+}
+
+FileStream::FileStream(FileName fileName, bool openReadOnly, unsigned int bufferSize)
+  : d(new FileStreamPrivate(fileName, bufferSize > 0 ? bufferSize : FileStream::bufferSize()))
+{
+  d->open(fileName, openReadOnly);
 }
 
 FileStream::~FileStream()
 {
-  if(isOpen())
+  if(isOpen()) {
+    d->commit();
     closeFile(d->file);
+  }
 
   delete d;
 }
@@ -182,7 +610,7 @@ ByteVector FileStream::readBlock(unsigned long length)
     return ByteVector();
 
   const unsigned long streamLength = static_cast<unsigned long>(FileStream::length());
-  if(length > bufferSize() && length > streamLength)
+  if(length > d->bufferSize && length > streamLength)
     length = streamLength;
 
   ByteVector buffer(static_cast<unsigned int>(length));
@@ -205,7 +633,14 @@ void FileStream::writeBlock(const ByteVector &data)
     return;
   }
 
+  if(d->originalFile < 0)
+    d->writeToCopy(ByteVector(), 0, 0);
+
   writeFile(d->file, data);
+
+  const long position = tell();
+  if(position > d->size)
+    d->size = position;
 }
 
 void FileStream::insert(const ByteVector &data, unsigned long start, unsigned long replace)
@@ -225,7 +660,45 @@ void FileStream::insert(const ByteVector &data, unsigned long start, unsigned lo
     writeBlock(data);
     return;
   }
-  else if(data.size() < replace) {
+
+  if(d->writeToCopy(data, start, replace))
+    return;
+
+  // If the file system supports it and the size changes by whole blocks, add
+  // or remove the blocks at a block boundary within the replaced range and
+  // then just overwrite the range.  This avoids rewriting the rest of the
+  // file.
+
+  const long block = blockSize(d->file);
+
+  if(data.size() > replace) {
+    const long growth = static_cast<long>(data.size() - replace);
+    if(block > 0 && growth % block == 0) {
+      const long offset = static_cast<long>(start + replace) / block * block;
+      if(offset >= static_cast<long>(start) && offset < d->size
+         && insertRange(d->file, offset, growth))
+      {
+        d->size += growth;
+        seek(start);
+        writeBlock(data);
+        return;
+      }
+    }
+  }
+  else {
+    const long shrinkage = static_cast<long>(replace - data.size());
+    if(block > 0 && shrinkage % block == 0) {
+      const long offset = (static_cast<long>(start) + block - 1) / block * block;
+      if(offset + shrinkage <= static_cast<long>(start + replace) && offset + shrinkage < d->size
+         && collapseRange(d->file, offset, shrinkage))
+      {
+        d->size -= shrinkage;
+        seek(start);
+        writeBlock(data);
+        return;
+      }
+    }
+
     seek(start);
     writeBlock(data);
     removeBlock(start + data.size(), replace - data.size());
@@ -242,10 +715,16 @@ void FileStream::insert(const ByteVector &data, unsigned long start, unsigned lo
   // the *differnce* in the tag sizes.  We want to avoid overwriting parts
   // that aren't yet in memory, so this is necessary.
 
-  unsigned long bufferLength = bufferSize();
+  unsigned long bufferLength = d->bufferSize;
 
   while(data.size() - replace > bufferLength)
-    bufferLength += bufferSize();
+    bufferLength += d->bufferSize;
+
+  // Then grow it to move the rest of the file in as few steps as possible.
+
+  const long bytesToMove = length() - static_cast<long>(start + replace);
+  if(bytesToMove > 0)
+    bufferLength = copyBufferSize(bufferLength, bytesToMove);
 
   // Set where to start the reading and writing.
 
@@ -253,13 +732,15 @@ void FileStream::insert(const ByteVector &data, unsigned long start, unsigned lo
   long writePosition = start;
 
   ByteVector buffer = data;
-  ByteVector aboutToOverwrite(static_cast<unsigned int>(bufferLength));
+  ByteVector aboutToOverwrite;
 
   while(true)
   {
     // Seek to the current read position and read the data that we're about
     // to overwrite.  Appropriately increment the readPosition.
 
+    aboutToOverwrite.resize(static_cast<unsigned int>(bufferLength));
+
     seek(readPosition);
     const unsigned int bytesRead = static_cast<unsigned int>(readFile(d->file, aboutToOverwrite));
     aboutToOverwrite.resize(bytesRead);
@@ -284,9 +765,11 @@ void FileStream::insert(const ByteVector &data, unsigned long start, unsigned lo
 
     writePosition += buffer.size();
 
-    // Make the current buffer the data that we read in the beginning.
+    // Make the current buffer the data that we read in the beginning.  The
+    // buffers are swapped rather than copied, so that the old one can be
+    // reused for the next read.
 
-    buffer = aboutToOverwrite;
+    buffer.swap(aboutToOverwrite);
   }
 }
 
@@ -297,11 +780,32 @@ void FileStream::removeBlock(unsigned long start, unsigned long length)
     return;
   }
 
-  unsigned long bufferLength = bufferSize();
+  if(readOnly()) {
+    debug("FileStream::removeBlock() -- read only file.");
+    return;
+  }
+
+  if(length > 0 && d->writeToCopy(ByteVector(), start, length))
+    return;
+
+  // Remove whole blocks without moving the rest of the file if possible.
+
+  const long block = blockSize(d->file);
+  if(block > 0 && start % block == 0 && length % block == 0
+     && static_cast<long>(start + length) < d->size
+     && collapseRange(d->file, start, length))
+  {
+    d->size -= length;
+    return;
+  }
 
   long readPosition = start + length;
   long writePosition = start;
 
+  const long bytesToMove = FileStream::length() - readPosition;
+  const unsigned long bufferLength
+    = copyBufferSize(d->bufferSize, bytesToMove > 0 ? bytesToMove : 0);
+
   ByteVector buffer(static_cast<unsigned int>(bufferLength));
 
   for(unsigned int bytesRead = -1; bytesRead != 0;)
@@ -319,7 +823,7 @@ void FileStream::removeBlock(unsigned long start, unsigned long length)
     }
 
     seek(writePosition);
-    writeFile(d->file, buffer);
+    writeBlock(buffer);
 
     writePosition += bytesRead;
   }
@@ -358,6 +862,33 @@ void FileStream::seek(long offset, Position p)
     debug("FileStream::seek() -- Failed to set the file pointer.");
   }
 
+#elif defined(HAVE_PREAD)
+
+  long position;
+  switch(p) {
+  case Beginning:
+    position = offset;
+    break;
+  case Current:
+    position = d->file->position + offset;
+    break;
+  case End:
+    position = d->size + offset;
+    break;
+  default:
+    debug("FileStream::seek() -- Invalid Position value.");
+    return;
+  }
+
+  // Same as fseek(), seeking before the beginning of the file fails.
+
+  if(position < 0) {
+    debug("FileStream::seek() -- Failed to set the file pointer.");
+    return;
+  }
+
+  d->file->position = position;
+
 #else
 
   int whence;
@@ -383,7 +914,7 @@ void FileStream::seek(long offset, Position p)
 
 void FileStream::clear()
 {
-#ifdef _WIN32
+#if defined(_WIN32) || defined(HAVE_PREAD)
 
   // NOP
 
@@ -409,6 +940,10 @@ long FileStream::tell() const
     return 0;
   }
 
+#elif defined(HAVE_PREAD)
+
+  return d->file->position;
+
 #else
 
   return ftell(d->file);
@@ -423,30 +958,42 @@ long FileStream::length()
     return 0;
   }
 
-#ifdef _WIN32
-
-  LARGE_INTEGER fileSize;
+  return d->size;
+}
 
-  if(GetFileSizeEx(d->file, &fileSize) && fileSize.QuadPart <= LONG_MAX) {
-    return static_cast<long>(fileSize.QuadPart);
-  }
-  else {
-    debug("FileStream::length() -- Failed to get the file size.");
+long FileStream::resizeAlignment() const
+{
+  if(!isOpen())
     return 0;
-  }
 
-#else
+  return blockSize(d->file);
+}
 
-  const long curpos = tell();
+void FileStream::setReplaceFile(bool replace)
+{
+  if(!replace)
+    commit();
 
-  seek(0, End);
-  const long endpos = tell();
+  d->replaceFile = replace;
+}
 
-  seek(curpos, Beginning);
+bool FileStream::replaceFile() const
+{
+  return d->replaceFile;
+}
 
-  return endpos;
+bool FileStream::commit()
+{
+  if(!isOpen())
+    return true;
 
-#endif
+  return d->commit();
+}
+
+void FileStream::setBufferSize(unsigned int size) // static
+{
+  if(size > 0)
+    streamBufferSize = size;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -464,20 +1011,44 @@ void FileStream::truncate(long length)
   if(!SetEndOfFile(d->file)) {
     debug("FileStream::truncate() -- Failed to truncate the file.");
   }
+  else {
+    d->size = length;
+  }
 
   seek(currentPos);
 
+#elif defined(HAVE_PREAD)
+
+  if(d->originalFile < 0)
+    d->writeToCopy(ByteVector(), 0, 0);
+
+  const int error = ftruncate(d->file->fd, length);
+  if(error != 0) {
+    debug("FileStream::truncate() -- Coundn't truncate the file.");
+  }
+  else {
+    d->size = length;
+  }
+
 #else
 
+  // Flush the pending writes first, so that they don't extend the file
+  // again after it has been truncated.
+
+  fflush(d->file);
+
   const int error = ftruncate(fileno(d->file), length);
   if(error != 0) {
     debug("FileStream::truncate() -- Coundn't truncate the file.");
   }
+  else {
+    d->size = length;
+  }
 
 #endif
 }
 
 unsigned int FileStream::bufferSize()
 {
-  return 1024;
+  return streamBufferSize;
 }
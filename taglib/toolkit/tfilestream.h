@@ -54,6 +54,15 @@ namespace TagLib {
      */
     FileStream(FileName file, bool openReadOnly = false);
 
+    /*!
+     * Construct a File object and opens the \a file like the constructor
+     * above, using \a bufferSize as the smallest buffer for moving data
+     * around in insert() and removeBlock() instead of the global bufferSize().
+     *
+     * \see setBufferSize()
+     */
+    FileStream(FileName file, bool openReadOnly, unsigned int bufferSize);
+
     /*!
      * Destroys this FileStream instance.
      */
@@ -85,7 +94,8 @@ namespace TagLib {
      * bytes of the original content.
      *
      * \note This method is slow since it requires rewriting all of the file
-     * after the insertion point.
+     * after the insertion point.  On Linux file systems that support it, a
+     * change in size by a whole number of blocks is done in place instead.
      */
     void insert(const ByteVector &data, unsigned long start = 0, unsigned long replace = 0);
 
@@ -94,7 +104,8 @@ namespace TagLib {
      * \a length bytes.
      *
      * \note This method is slow since it involves rewriting all of the file
-     * after the removed portion.
+     * after the removed portion.  On Linux file systems that support it,
+     * removing whole blocks at a block boundary is done in place instead.
      */
     void removeBlock(unsigned long start = 0, unsigned long length = 0);
 
@@ -129,18 +140,90 @@ namespace TagLib {
 
     /*!
      * Returns the length of the file.
+     *
+     * \note The length is queried once when the file is opened and then kept
+     * up to date by the methods of this class.  Changes made to the file by
+     * other processes or through other streams are not noticed.
      */
     long length();
 
+    /*!
+     * Returns the multiple of bytes by which insert() and removeBlock() may
+     * change the size of the file without moving the data after the change,
+     * or 0 if they always move it.  This is the block size of the file
+     * system on Linux, and 0 elsewhere.
+     *
+     * Formats that pad their tags round the growth of the tags up to this.
+     */
+    long resizeAlignment() const;
+
     /*!
      * Truncates the file to a \a length.
      */
     void truncate(long length);
 
+    /*!
+     * If \a replace is true, the file is not modified directly.  The first
+     * change after this call copies it to a temporary file in the same
+     * directory, and all changes go to that copy until commit() renames it
+     * over the original.  If this is interrupted, either the old or the new
+     * file is left, but never a partly modified one.
+     *
+     * If the first change is one of size, it is applied while copying, and
+     * later changes are made in place in the copy.  The data is copied with
+     * copy_file_range() where available, which shares the blocks instead of
+     * copying them on file systems with reflinks.
+     *
+     * Files that are symbolic links or have more than one hard link, and
+     * platforms that don't support this, are still modified in place.
+     *
+     * By default this is false.
+     *
+     * \see commit()
+     */
+    void setReplaceFile(bool replace);
+
+    /*!
+     * Returns true if changes are written to a copy of the file that then
+     * replaces it.
+     *
+     * \see setReplaceFile()
+     */
+    bool replaceFile() const;
+
+    /*!
+     * Renames the copy that the changes since the last commit() were written
+     * to over the file, after syncing it to the disk, and then syncs the
+     * directory.  If the file cannot be replaced, the changes are written to
+     * it in place and this returns false.  Returns true if it has been
+     * replaced or there is nothing to commit.
+     *
+     * This is called when the stream is destroyed or setReplaceFile() turns
+     * the copying off.
+     *
+     * \see setReplaceFile()
+     */
+    bool commit();
+
+    /*!
+     * Sets the buffer size that is used for internal buffering by the streams
+     * created after this call.  The default is 1024 bytes.
+     *
+     * insert() and removeBlock() start with a buffer of this size and grow it
+     * up to a few megabytes when they have to move a lot of data, so this is
+     * rarely worth changing.
+     *
+     * \note This is a global setting and is not thread safe.  It should be set
+     * before any files are opened.
+     */
+    static void setBufferSize(unsigned int size);
+
   protected:
 
     /*!
      * Returns the buffer size that is used for internal buffering.
+     *
+     * \see setBufferSize()
      */
     static unsigned int bufferSize();
 
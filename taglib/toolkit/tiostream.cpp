@@ -28,10 +28,33 @@
 # include <tstring.h>
 #endif
 
+#include <algorithm>
+#include <vector>
+
 #include "tiostream.h"
 
 using namespace TagLib;
 
+namespace
+{
+  // readBlocks() reads blocks that are less than this far apart with a
+  // single read, since a few unneeded bytes are cheaper than another call.
+
+  const long MaxGapBetweenBlocks = 4096;
+
+  struct Block
+  {
+    long begin;
+    long end;
+    unsigned int index;
+
+    bool operator<(const Block &other) const
+    {
+      return begin < other.begin;
+    }
+  };
+}
+
 #ifdef _WIN32
 
 namespace
@@ -112,3 +135,61 @@ void IOStream::clear()
 {
 }
 
+ByteVectorList IOStream::readBlocks(const List<Range> &ranges)
+{
+  std::vector<ByteVector> blocks(ranges.size());
+
+  const long streamLength = length();
+
+  // Resolve the ranges to absolute offsets within the stream, leaving out the
+  // ones that can't be read, and sort them so that neighbours can be merged.
+
+  std::vector<Block> sorted;
+  sorted.reserve(ranges.size());
+
+  unsigned int index = 0;
+  for(List<Range>::ConstIterator it = ranges.begin(); it != ranges.end(); ++it, ++index) {
+    Block block;
+    block.begin = (it->offset < 0) ? streamLength + it->offset : it->offset;
+    block.end   = std::min(block.begin + static_cast<long>(it->length), streamLength);
+    block.index = index;
+
+    if(block.begin >= 0 && block.begin < block.end)
+      sorted.push_back(block);
+  }
+
+  std::sort(sorted.begin(), sorted.end());
+
+  const long originalPosition = tell();
+
+  std::vector<Block>::const_iterator first = sorted.begin();
+  while(first != sorted.end()) {
+
+    std::vector<Block>::const_iterator last = first + 1;
+
+    const long begin = first->begin;
+    long end = first->end;
+
+    while(last != sorted.end() && last->begin <= end + MaxGapBetweenBlocks) {
+      end = std::max(end, last->end);
+      ++last;
+    }
+
+    seek(begin);
+    const ByteVector data = readBlock(end - begin);
+
+    for(; first != last; ++first) {
+      blocks[first->index] = data.mid(static_cast<unsigned int>(first->begin - begin),
+                                      static_cast<unsigned int>(first->end - first->begin));
+    }
+  }
+
+  seek(originalPosition);
+
+  ByteVectorList result;
+  for(std::vector<ByteVector>::const_iterator it = blocks.begin(); it != blocks.end(); ++it)
+    result.append(*it);
+
+  return result;
+}
+
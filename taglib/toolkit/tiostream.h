@@ -29,6 +29,7 @@
 #include "taglib_export.h"
 #include "taglib.h"
 #include "tbytevector.h"
+#include "tbytevectorlist.h"
 
 namespace TagLib {
 
@@ -74,6 +75,18 @@ namespace TagLib {
       End
     };
 
+    /*!
+     * A block of \a length bytes at \a offset to be read by readBlocks().  A
+     * negative \a offset is relative to the end of the stream.
+     */
+    struct Range
+    {
+      Range(long offset, unsigned int length) : offset(offset), length(length) {}
+
+      long offset;
+      unsigned int length;
+    };
+
     IOStream();
 
     /*!
@@ -160,6 +173,20 @@ namespace TagLib {
      */
     virtual void truncate(long length) = 0;
 
+    /*!
+     * Reads the blocks described by \a ranges and returns them in the same
+     * order.  Blocks that are close to each other are read together, so that
+     * e.g. looking for several tags at the end of a file takes a single read.
+     * A block that lies partly outside of the stream is truncated, and one
+     * that lies wholly or partly before the beginning of the stream is
+     * returned empty.
+     *
+     * The current position in the stream is not changed.
+     *
+     * BIC: Will be made virtual in future releases.
+     */
+    ByteVectorList readBlocks(const List<Range> &ranges);
+
   private:
     IOStream(const IOStream &);
     IOStream &operator=(const IOStream &);
@@ -70,6 +70,14 @@ namespace TagLib {
      */
     List(const List<T> &l);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Constructs a list that takes over the items of \a l.  \a l is left
+     * empty.
+     */
+    List(List<T> &&l);
+#endif
+
     /*!
      * Destroys this List instance.  If auto deletion is enabled and this list
      * contains a pointer type all of the members are also deleted.
@@ -105,6 +113,13 @@ namespace TagLib {
      */
     Iterator insert(Iterator it, const T &value);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Moves \a value into the list before \a it.
+     */
+    Iterator insert(Iterator it, T &&value);
+#endif
+
     /*!
      * Inserts the \a value into the list.  This assumes that the list is
      * currently sorted.  If \a unique is true then the value will not
@@ -118,6 +133,14 @@ namespace TagLib {
      */
     List<T> &append(const T &item);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Moves \a item to the end of the list and returns a reference to the
+     * list.
+     */
+    List<T> &append(T &&item);
+#endif
+
     /*!
      * Appends all of the values in \a l to the end of the list and returns a
      * reference to the list.
@@ -130,6 +153,14 @@ namespace TagLib {
      */
     List<T> &prepend(const T &item);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Moves \a item to the beginning of the list and returns a reference to
+     * the list.
+     */
+    List<T> &prepend(T &&item);
+#endif
+
     /*!
      * Prepends all of the items in \a l to the beginning list and returns a
      * reference to the list.
@@ -229,6 +260,13 @@ namespace TagLib {
      */
     List<T> &operator=(const List<T> &l);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Takes over the items of \a l.  \a l is left empty.
+     */
+    List<T> &operator=(List<T> &&l);
+#endif
+
     /*!
      * Exchanges the content of this list by the content of \a l.
      */
@@ -24,6 +24,7 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <utility>
 #include "trefcounter.h"
 
 namespace TagLib {
@@ -100,6 +101,16 @@ List<T>::List(const List<T> &l) : d(l.d)
   d->ref();
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+template <class T>
+List<T>::List(List<T> &&l) : d(l.d)
+{
+  l.d = new ListPrivate<T>();
+}
+
+#endif
+
 template <class T>
 List<T>::~List()
 {
@@ -140,6 +151,17 @@ typename List<T>::Iterator List<T>::insert(Iterator it, const T &item)
   return d->list.insert(it, item);
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+template <class T>
+typename List<T>::Iterator List<T>::insert(Iterator it, T &&item)
+{
+  detach();
+  return d->list.insert(it, std::move(item));
+}
+
+#endif
+
 template <class T>
 List<T> &List<T>::sortedInsert(const T &value, bool unique)
 {
@@ -161,6 +183,18 @@ List<T> &List<T>::append(const T &item)
   return *this;
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+template <class T>
+List<T> &List<T>::append(T &&item)
+{
+  detach();
+  d->list.push_back(std::move(item));
+  return *this;
+}
+
+#endif
+
 template <class T>
 List<T> &List<T>::append(const List<T> &l)
 {
@@ -177,6 +211,18 @@ List<T> &List<T>::prepend(const T &item)
   return *this;
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+template <class T>
+List<T> &List<T>::prepend(T &&item)
+{
+  detach();
+  d->list.push_front(std::move(item));
+  return *this;
+}
+
+#endif
+
 template <class T>
 List<T> &List<T>::prepend(const List<T> &l)
 {
@@ -287,6 +333,17 @@ List<T> &List<T>::operator=(const List<T> &l)
   return *this;
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+template <class T>
+List<T> &List<T>::operator=(List<T> &&l)
+{
+  List<T>(std::move(l)).swap(*this);
+  return *this;
+}
+
+#endif
+
 template <class T>
 void List<T>::swap(List<T> &l)
 {
@@ -73,6 +73,14 @@ namespace TagLib {
      */
     Map(const Map<Key, T> &m);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Constructs a map that takes over the elements of \a m.  \a m is left
+     * empty.
+     */
+    Map(Map<Key, T> &&m);
+#endif
+
     /*!
      * Destroys this instance of the Map.
      */
@@ -108,6 +116,14 @@ namespace TagLib {
      */
     Map<Key, T> &insert(const Key &key, const T &value);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Moves \a value into the map under \a key.  If a value for \a key already
+     * exists it will be overwritten.
+     */
+    Map<Key, T> &insert(const Key &key, T &&value);
+#endif
+
     /*!
      * Removes all of the elements from elements from the map.  This however
      * will not delete pointers if the mapped type is a pointer type.
@@ -174,6 +190,13 @@ namespace TagLib {
      */
     Map<Key, T> &operator=(const Map<Key, T> &m);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Takes over the elements of \a m.  \a m is left empty.
+     */
+    Map<Key, T> &operator=(Map<Key, T> &&m);
+#endif
+
     /*!
      * Exchanges the content of this map by the content of \a m.
      */
@@ -23,6 +23,7 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#include <utility>
 #include "trefcounter.h"
 
 namespace TagLib {
@@ -59,6 +60,16 @@ Map<Key, T>::Map(const Map<Key, T> &m) : d(m.d)
   d->ref();
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+template <class Key, class T>
+Map<Key, T>::Map(Map<Key, T> &&m) : d(m.d)
+{
+  m.d = new MapPrivate<Key, T>();
+}
+
+#endif
+
 template <class Key, class T>
 Map<Key, T>::~Map()
 {
@@ -100,6 +111,18 @@ Map<Key, T> &Map<Key, T>::insert(const Key &key, const T &value)
   return *this;
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+template <class Key, class T>
+Map<Key, T> &Map<Key, T>::insert(const Key &key, T &&value)
+{
+  detach();
+  d->map[key] = std::move(value);
+  return *this;
+}
+
+#endif
+
 template <class Key, class T>
 Map<Key, T> &Map<Key, T>::clear()
 {
@@ -175,6 +198,17 @@ Map<Key, T> &Map<Key, T>::operator=(const Map<Key, T> &m)
   return *this;
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+template <class Key, class T>
+Map<Key, T> &Map<Key, T>::operator=(Map<Key, T> &&m)
+{
+  Map<Key, T>(std::move(m)).swap(*this);
+  return *this;
+}
+
+#endif
+
 template <class Key, class T>
 void Map<Key, T>::swap(Map<Key, T> &m)
 {
@@ -0,0 +1,297 @@
+/***************************************************************************
+    copyright            : (C) 2026 by the TagLib developers
+    email                :
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <climits>
+
+#include "tmemorymappedstream.h"
+#include "tstring.h"
+#include "tdebug.h"
+
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+#endif
+
+using namespace TagLib;
+
+namespace
+{
+#ifdef _WIN32
+
+  typedef FileName FileNameHandle;
+
+  // Maps the whole file.  Returns a null pointer and sets the size to zero if
+  // the file is empty, since empty files can't be mapped.
+
+  const char *mapFile(const FileName &path, unsigned long &size, bool &opened)
+  {
+    size   = 0;
+    opened = false;
+
+#if defined(_WIN32_WINNT) && (_WIN32_WINNT >= 0x0602)
+    const HANDLE file = CreateFile2(path.wstr().c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, NULL);
+#else
+    const HANDLE file = CreateFileW(path.wstr().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+#endif
+    if(file == INVALID_HANDLE_VALUE)
+      return 0;
+
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart > LONG_MAX) {
+      CloseHandle(file);
+      return 0;
+    }
+
+    opened = true;
+
+    if(fileSize.QuadPart == 0) {
+      CloseHandle(file);
+      return 0;
+    }
+
+    const HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+
+    if(!mapping) {
+      opened = false;
+      return 0;
+    }
+
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if(!view) {
+      opened = false;
+      return 0;
+    }
+
+    size = static_cast<unsigned long>(fileSize.QuadPart);
+    return static_cast<const char *>(view);
+  }
+
+  void unmapFile(const char *data, unsigned long)
+  {
+    UnmapViewOfFile(data);
+  }
+
+#else   // _WIN32
+
+  struct FileNameHandle : public std::string
+  {
+    FileNameHandle(FileName name) : std::string(name) {}
+    operator FileName () const { return c_str(); }
+  };
+
+  // Maps the whole file.  Returns a null pointer and sets the size to zero if
+  // the file is empty, since empty files can't be mapped.
+
+  const char *mapFile(const FileName &path, unsigned long &size, bool &opened)
+  {
+    size   = 0;
+    opened = false;
+
+    const int fd = ::open(path, O_RDONLY);
+    if(fd < 0)
+      return 0;
+
+    struct stat st;
+    if(::fstat(fd, &st) != 0 || st.st_size > LONG_MAX) {
+      ::close(fd);
+      return 0;
+    }
+
+    opened = true;
+
+    if(st.st_size == 0) {
+      ::close(fd);
+      return 0;
+    }
+
+    // The mapping stays valid after the descriptor has been closed.
+
+    void *mapping = ::mmap(0, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if(mapping == MAP_FAILED) {
+      opened = false;
+      return 0;
+    }
+
+    size = static_cast<unsigned long>(st.st_size);
+    return static_cast<const char *>(mapping);
+  }
+
+  void unmapFile(const char *data, unsigned long size)
+  {
+    ::munmap(const_cast<char *>(data), size);
+  }
+
+#endif  // _WIN32
+}
+
+class MemoryMappedStream::MemoryMappedStreamPrivate
+{
+public:
+  MemoryMappedStreamPrivate(const FileName &fileName) :
+    name(fileName),
+    data(0),
+    size(0),
+    position(0),
+    opened(false) {}
+
+  FileNameHandle name;
+  const char *data;
+  unsigned long size;
+  long position;
+  bool opened;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+MemoryMappedStream::MemoryMappedStream(FileName fileName) :
+  d(new MemoryMappedStreamPrivate(fileName))
+{
+  d->data = mapFile(fileName, d->size, d->opened);
+
+  if(!d->opened) {
+# ifdef _WIN32
+    debug("Could not map file " + fileName.toString());
+# else
+    debug("Could not map file " + String(static_cast<const char *>(d->name)));
+# endif
+  }
+}
+
+MemoryMappedStream::~MemoryMappedStream()
+{
+  if(d->data)
+    unmapFile(d->data, d->size);
+
+  delete d;
+}
+
+FileName MemoryMappedStream::name() const
+{
+  return d->name;
+}
+
+ByteVector MemoryMappedStream::readBlock(unsigned long length)
+{
+  if(!isOpen()) {
+    debug("MemoryMappedStream::readBlock() -- invalid file.");
+    return ByteVector();
+  }
+
+  if(length == 0 || static_cast<unsigned long>(d->position) >= d->size)
+    return ByteVector();
+
+  length = std::min(length, d->size - d->position);
+
+  const ByteVector block(d->data + d->position, static_cast<unsigned int>(length));
+  d->position += static_cast<long>(length);
+
+  return block;
+}
+
+void MemoryMappedStream::writeBlock(const ByteVector &)
+{
+  debug("MemoryMappedStream::writeBlock() -- read only file.");
+}
+
+void MemoryMappedStream::insert(const ByteVector &, unsigned long, unsigned long)
+{
+  debug("MemoryMappedStream::insert() -- read only file.");
+}
+
+void MemoryMappedStream::removeBlock(unsigned long, unsigned long)
+{
+  debug("MemoryMappedStream::removeBlock() -- read only file.");
+}
+
+bool MemoryMappedStream::readOnly() const
+{
+  return true;
+}
+
+bool MemoryMappedStream::isOpen() const
+{
+  return d->opened;
+}
+
+void MemoryMappedStream::seek(long offset, Position p)
+{
+  if(!isOpen()) {
+    debug("MemoryMappedStream::seek() -- invalid file.");
+    return;
+  }
+
+  long position;
+  switch(p) {
+  case Beginning:
+    position = offset;
+    break;
+  case Current:
+    position = d->position + offset;
+    break;
+  case End:
+    position = static_cast<long>(d->size) + offset;
+    break;
+  default:
+    debug("MemoryMappedStream::seek() -- Invalid Position value.");
+    return;
+  }
+
+  // Behave like fseek(): seeking before the beginning fails, seeking past the
+  // end is allowed.
+
+  if(position < 0) {
+    debug("MemoryMappedStream::seek() -- Failed to set the file pointer.");
+    return;
+  }
+
+  d->position = position;
+}
+
+long MemoryMappedStream::tell() const
+{
+  return d->position;
+}
+
+long MemoryMappedStream::length()
+{
+  return static_cast<long>(d->size);
+}
+
+void MemoryMappedStream::truncate(long)
+{
+  debug("MemoryMappedStream::truncate() -- read only file.");
+}
@@ -0,0 +1,132 @@
+/***************************************************************************
+    copyright            : (C) 2026 by the TagLib developers
+    email                :
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_MEMORYMAPPEDSTREAM_H
+#define TAGLIB_MEMORYMAPPEDSTREAM_H
+
+#include "taglib_export.h"
+#include "taglib.h"
+#include "tbytevector.h"
+#include "tiostream.h"
+
+namespace TagLib {
+
+  //! A read-only stream that maps the whole file into memory
+
+  /*!
+   * This is an alternative to FileStream for applications which only read
+   * tags, e.g. library scanners.  The file is mapped into the address space
+   * once when the stream is opened, so readBlock(), seek() and length() don't
+   * issue any system calls and the data does not go through the stdio buffer.
+   *
+   * The stream is always read only.  Writing to it is not possible, so files
+   * opened through a MemoryMappedStream can not be saved.
+   *
+   * \note The file must not be truncated by another process while it is
+   * mapped.  Accessing the truncated part of the mapping results in SIGBUS
+   * on most systems.
+   */
+
+  class TAGLIB_EXPORT MemoryMappedStream : public IOStream
+  {
+  public:
+    /*!
+     * Opens and maps \a file.  \a file should be a C-string in the local file
+     * system encoding.
+     */
+    MemoryMappedStream(FileName file);
+
+    /*!
+     * Unmaps and closes the file.
+     */
+    virtual ~MemoryMappedStream();
+
+    /*!
+     * Returns the file name in the local file system encoding.
+     */
+    FileName name() const;
+
+    /*!
+     * Reads a block of size \a length at the current get pointer.  The data is
+     * copied straight out of the mapping without calling into the system.
+     */
+    ByteVector readBlock(unsigned long length);
+
+    /*!
+     * Does nothing, since the stream is read only.
+     */
+    void writeBlock(const ByteVector &data);
+
+    /*!
+     * Does nothing, since the stream is read only.
+     */
+    void insert(const ByteVector &data, unsigned long start = 0, unsigned long replace = 0);
+
+    /*!
+     * Does nothing, since the stream is read only.
+     */
+    void removeBlock(unsigned long start = 0, unsigned long length = 0);
+
+    /*!
+     * Always returns true.
+     */
+    bool readOnly() const;
+
+    /*!
+     * Returns true if the file has been opened and mapped successfully.
+     */
+    bool isOpen() const;
+
+    /*!
+     * Move the I/O pointer to \a offset in the file from position \a p.  This
+     * defaults to seeking from the beginning of the file.
+     *
+     * \see Position
+     */
+    void seek(long offset, Position p = Beginning);
+
+    /*!
+     * Returns the current offset within the file.
+     */
+    long tell() const;
+
+    /*!
+     * Returns the length of the file.
+     */
+    long length();
+
+    /*!
+     * Does nothing, since the stream is read only.
+     */
+    void truncate(long length);
+
+  private:
+    class MemoryMappedStreamPrivate;
+    MemoryMappedStreamPrivate *d;
+  };
+
+}
+
+#endif
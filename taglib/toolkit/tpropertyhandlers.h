@@ -0,0 +1,106 @@
+/***************************************************************************
+    copyright            : (C) 2026 by the TagLib developers
+    email                :
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_PROPERTYHANDLERS_H
+#define TAGLIB_PROPERTYHANDLERS_H
+
+// THIS FILE IS NOT A PART OF THE TAGLIB API
+
+#ifndef DO_NOT_DOCUMENT  // tell Doxygen not to document this header
+
+#include "tfile.h"
+#include "tpropertymap.h"
+
+namespace TagLib {
+
+  namespace Utils {
+
+    // Forwards the PropertyMap interface of File to the methods of the same
+    // name in the subclass T.
+
+    // Only instantiable when T declares the method itself: a pointer to a
+    // member inherited from File has a different type and is rejected, which
+    // keeps PropertyForwarder from calling back into File's dispatcher.
+
+    template <class T, void (T::*)(const StringList &)>
+    struct DeclaresRemoveUnsupportedProperties
+    {
+    };
+
+    template <class T>
+    class PropertyForwarder
+    {
+    public:
+      static PropertyMap properties(const File *file)
+      {
+        return static_cast<const T *>(file)->properties();
+      }
+
+      static void removeUnsupportedProperties(File *file, const StringList &properties)
+      {
+        static_cast<T *>(file)->removeUnsupportedProperties(properties);
+      }
+
+      static PropertyMap setProperties(File *file, const PropertyMap &properties)
+      {
+        return static_cast<T *>(file)->setProperties(properties);
+      }
+    };
+
+    // Returns the handlers to be passed to File::setPropertyHandlers() by the
+    // constructors of T.
+
+    template <class T>
+    const File::PropertyHandlers *propertyHandlers()
+    {
+      typedef DeclaresRemoveUnsupportedProperties<T, &T::removeUnsupportedProperties> Check;
+      (void)sizeof(Check);
+      static const File::PropertyHandlers handlers = {
+        &PropertyForwarder<T>::properties,
+        &PropertyForwarder<T>::removeUnsupportedProperties,
+        &PropertyForwarder<T>::setProperties
+      };
+      return &handlers;
+    }
+
+    // The same for subclasses that leave removeUnsupportedProperties() to
+    // their tag.
+
+    template <class T>
+    const File::PropertyHandlers *propertyHandlersWithoutRemove()
+    {
+      static const File::PropertyHandlers handlers = {
+        &PropertyForwarder<T>::properties,
+        0,
+        &PropertyForwarder<T>::setProperties
+      };
+      return &handlers;
+    }
+  }
+}
+
+#endif
+
+#endif
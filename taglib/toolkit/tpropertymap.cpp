@@ -23,8 +23,10 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#include <utility>
 
 #include "tpropertymap.h"
+
 using namespace TagLib;
 
 
@@ -36,6 +38,16 @@ PropertyMap::PropertyMap(const PropertyMap &m) : SimplePropertyMap(m), unsupport
 {
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+PropertyMap::PropertyMap(PropertyMap &&m) :
+  SimplePropertyMap(std::move(m)),
+  unsupported(std::move(m.unsupported))
+{
+}
+
+#endif
+
 PropertyMap::PropertyMap(const SimplePropertyMap &m)
 {
   for(SimplePropertyMap::ConstIterator it = m.begin(); it != m.end(); ++it){
@@ -51,6 +63,24 @@ PropertyMap::~PropertyMap()
 {
 }
 
+PropertyMap &PropertyMap::operator=(const PropertyMap &m)
+{
+  SimplePropertyMap::operator=(m);
+  unsupported = m.unsupported;
+  return *this;
+}
+
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+PropertyMap &PropertyMap::operator=(PropertyMap &&m)
+{
+  SimplePropertyMap::operator=(std::move(m));
+  unsupported = std::move(m.unsupported);
+  return *this;
+}
+
+#endif
+
 bool PropertyMap::insert(const String &key, const StringList &values)
 {
   String realKey = key.upper();
@@ -116,6 +116,13 @@ namespace TagLib {
 
     PropertyMap(const PropertyMap &m);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Constructs a PropertyMap that takes over the entries of \a m.
+     */
+    PropertyMap(PropertyMap &&m);
+#endif
+
     /*!
      * Creates a PropertyMap initialized from a SimplePropertyMap. Copies all
      * entries from \a m that have valid keys.
@@ -125,6 +132,18 @@ namespace TagLib {
 
     virtual ~PropertyMap();
 
+    /*!
+     * Copies the entries and the unsupported data of \a m.
+     */
+    PropertyMap &operator=(const PropertyMap &m);
+
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Takes over the entries and the unsupported data of \a m.
+     */
+    PropertyMap &operator=(PropertyMap &&m);
+#endif
+
     /*!
      * Inserts \a values under \a key in the map.  If \a key already exists,
      * then \a values will be appended to the existing StringList.
@@ -25,13 +25,15 @@
 
 #include <cerrno>
 #include <climits>
+#include <utility>
 
 #include <tdebug.h>
 #include <tstringlist.h>
-#include <trefcounter.h>
 #include <tutils.h>
 #include <utf8/checked.h>
 
+#include "tatomic.h"
+
 #include "tstring.h"
 
 namespace
@@ -47,14 +49,50 @@ namespace
       return String::UTF16BE;
   }
 
+  // Returns the number of ASCII characters at the beginning of a string.
+  // Most tag text is ASCII, so the conversions below handle runs of it in
+  // bulk and only use the UTF8-CPP functions for the rest.  Eight bytes at a
+  // time are checked for a set high bit.
+
+  size_t asciiLength(const char *s, size_t length)
+  {
+    const unsigned long long highBits
+      = (static_cast<unsigned long long>(0x80808080U) << 32) | 0x80808080U;
+
+    size_t i = 0;
+    for(; i + 8 <= length; i += 8) {
+      unsigned long long x;
+      ::memcpy(&x, s + i, 8);
+      if(x & highBits)
+        break;
+    }
+
+    while(i < length && static_cast<unsigned char>(s[i]) < 0x80)
+      ++i;
+
+    return i;
+  }
+
+  size_t asciiLength(const wchar_t *s, size_t length)
+  {
+    size_t i = 0;
+    while(i < length && static_cast<unsigned int>(s[i]) < 0x80)
+      ++i;
+
+    return i;
+  }
+
   // Converts a Latin-1 string into UTF-16(without BOM/CPU byte order)
   // and copies it to the internal buffer.
   void copyFromLatin1(std::wstring &data, const char *s, size_t length)
   {
     data.resize(length);
+    if(length == 0)
+      return;
 
+    wchar_t *dst = &data[0];
     for(size_t i = 0; i < length; ++i)
-      data[i] = static_cast<unsigned char>(s[i]);
+      dst[i] = static_cast<unsigned char>(s[i]);
   }
 
   // Converts a UTF-8 string into UTF-16(without BOM/CPU byte order)
@@ -62,10 +100,36 @@ namespace
   void copyFromUTF8(std::wstring &data, const char *s, size_t length)
   {
     data.resize(length);
+    if(length == 0)
+      return;
+
+    const char *const end = s + length;
+    wchar_t *const begin = &data[0];
+    wchar_t *dst = begin;
 
     try {
-      const std::wstring::iterator dstEnd = utf8::utf8to16(s, s + length, data.begin());
-      data.resize(dstEnd - data.begin());
+      while(s < end) {
+        const size_t ascii = asciiLength(s, end - s);
+        for(size_t i = 0; i < ascii; ++i)
+          dst[i] = static_cast<unsigned char>(s[i]);
+
+        dst += ascii;
+        s   += ascii;
+        if(s == end)
+          break;
+
+        unsigned int c = utf8::next(s, end);
+        if(c > 0xffff) {
+          c -= 0x10000;
+          *dst++ = static_cast<wchar_t>(0xd800 + (c >> 10));
+          *dst++ = static_cast<wchar_t>(0xdc00 + (c & 0x3ff));
+        }
+        else {
+          *dst++ = static_cast<wchar_t>(c);
+        }
+      }
+
+      data.resize(dst - begin);
     }
     catch(const utf8::exception &e) {
       debug(String("String::copyFromUTF8() - UTF8-CPP error: ") + e.what());
@@ -73,6 +137,42 @@ namespace
     }
   }
 
+  // Returns true if the UTF-8 string can be decoded lazily, which requires it
+  // to be valid so that decoding cannot fail later.
+
+  bool isValidUTF8(const char *s, size_t length)
+  {
+    if(length == 0)
+      return false;
+
+    const char *const end = s + length;
+
+    while(true) {
+      s += asciiLength(s, end - s);
+      if(s == end)
+        return true;
+
+      if(utf8::internal::validate_next(s, end) != utf8::internal::UTF8_OK)
+        return false;
+    }
+  }
+
+  // Returns the number of UTF-16 code units of a valid UTF-8 string.  Four
+  // byte sequences become surrogate pairs.
+
+  size_t utf16Length(const std::string &s)
+  {
+    size_t length = 0;
+    for(std::string::const_iterator it = s.begin(); it != s.end(); ++it) {
+      const unsigned char c = static_cast<unsigned char>(*it);
+      if((c & 0xC0) != 0x80)
+        ++length;
+      if(c >= 0xF0)
+        ++length;
+    }
+    return length;
+  }
+
   // Helper functions to read a UTF-16 character from an array.
   template <typename T>
   unsigned short nextUTF16(const T **p);
@@ -95,6 +195,30 @@ namespace
     return u.w;
   }
 
+  // Copies UTF-16 code units, swapping their bytes if \a swap is set.
+  void copyUTF16(wchar_t *dst, const wchar_t *s, size_t length, bool swap)
+  {
+    for(size_t i = 0; i < length; ++i) {
+      const unsigned short c = static_cast<unsigned short>(s[i]);
+      dst[i] = swap ? Utils::byteSwap(c) : c;
+    }
+  }
+
+  void copyUTF16(wchar_t *dst, const char *s, size_t length, bool swap)
+  {
+    const bool bigEndian = ((Utils::systemByteOrder() == Utils::BigEndian) != swap);
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+
+    if(bigEndian) {
+      for(size_t i = 0; i < length; ++i)
+        dst[i] = static_cast<wchar_t>((p[i * 2] << 8) | p[i * 2 + 1]);
+    }
+    else {
+      for(size_t i = 0; i < length; ++i)
+        dst[i] = static_cast<wchar_t>(p[i * 2] | (p[i * 2 + 1] << 8));
+    }
+  }
+
   // Converts a UTF-16 (with BOM), UTF-16LE or UTF16-BE string into
   // UTF-16(without BOM/CPU byte order) and copies it to the internal buffer.
   template <typename T>
@@ -124,57 +248,130 @@ namespace
     }
 
     data.resize(length);
-    for(size_t i = 0; i < length; ++i) {
-      const unsigned short c = nextUTF16(&s);
-      if(swap)
-        data[i] = Utils::byteSwap(c);
-      else
-        data[i] = c;
-    }
+    if(length == 0)
+      return;
+
+    copyUTF16(&data[0], s, length, swap);
   }
 }
 
 namespace TagLib {
 
-class String::StringPrivate : public RefCounter
+class String::StringPrivate
 {
 public:
-  StringPrivate() :
-    RefCounter() {}
+  StringPrivate() {}
+
+  StringPrivate(const char *s, size_t length) :
+    utf8(s, length) {}
+
+  ~StringPrivate()
+  {
+    delete decoded.release();
+  }
+
+  /*!
+   * Returns the data shared by all default constructed and moved from
+   * strings, so that they need no allocations.  Strings do not reference
+   * count it, and detach() replaces it before any modification.
+   */
+  static StringPrivate *empty()
+  {
+    static StringPrivate e;
+    return &e;
+  }
+
+  /*!
+   * Returns true if the string was created from UTF-8 and has not been
+   * modified since, so that \a data is not used.
+   */
+  bool isPending() const
+  {
+    return data.empty() && !utf8.empty();
+  }
+
+  /*!
+   * Returns the string in UTF-16, decoding it first if it is pending.  The
+   * data may be shared, so const methods of several strings can get here
+   * from different threads at once.  Hence the decoded string is published
+   * through \a decoded, and \a data is left untouched.
+   */
+  const TagLib::wstring &wide()
+  {
+    if(!isPending())
+      return data;
+
+    TagLib::wstring *w = decoded.load();
+    if(!w) {
+      w = new TagLib::wstring();
+      copyFromUTF8(*w, utf8.data(), utf8.size());
+      if(!decoded.testAndSet(w)) {
+        delete w;
+        w = decoded.load();
+      }
+    }
+    return *w;
+  }
+
+  Utils::AtomicCounter counter;
 
   /*!
    * Stores string in UTF-16. The byte order depends on the CPU endian.
    */
   TagLib::wstring data;
 
+  /*!
+   * Holds the string in UTF-8 if it was created from valid UTF-8 and has not
+   * been modified since.
+   */
+  std::string utf8;
+
+  /*!
+   * Holds \a utf8 decoded to UTF-16 once something has needed it.
+   */
+  Utils::AtomicPointer<TagLib::wstring> decoded;
+
   /*!
    * This is only used to hold the the most recent value of toCString().
    */
   std::string cstring;
 };
 
-String String::null;
+String String::null("");
 
 ////////////////////////////////////////////////////////////////////////////////
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
 String::String() :
-  d(new StringPrivate())
+  d(StringPrivate::empty())
 {
 }
 
 String::String(const String &s) :
   d(s.d)
 {
-  d->ref();
+  if(d != StringPrivate::empty())
+    d->counter.ref();
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+String::String(String &&s) :
+  d(s.d)
+{
+  s.d = StringPrivate::empty();
+}
+
+#endif
+
 String::String(const std::string &s, Type t) :
   d(new StringPrivate())
 {
   if(t == Latin1)
     copyFromLatin1(d->data, s.c_str(), s.length());
+  else if(t == String::UTF8 && isValidUTF8(s.c_str(), s.length()))
+    d->utf8 = s;
   else if(t == String::UTF8)
     copyFromUTF8(d->data, s.c_str(), s.length());
   else {
@@ -221,10 +418,14 @@ String::String(const wchar_t *s, Type t) :
 String::String(const char *s, Type t) :
   d(new StringPrivate())
 {
+  const size_t length = ::strlen(s);
+
   if(t == Latin1)
-    copyFromLatin1(d->data, s, ::strlen(s));
+    copyFromLatin1(d->data, s, length);
+  else if(t == String::UTF8 && isValidUTF8(s, length))
+    d->utf8.assign(s, length);
   else if(t == String::UTF8)
-    copyFromUTF8(d->data, s, ::strlen(s));
+    copyFromUTF8(d->data, s, length);
   else {
     debug("String::String() -- const char * should not contain UTF16.");
   }
@@ -260,6 +461,11 @@ String::String(const ByteVector &v, Type t) :
 
   if(t == Latin1)
     copyFromLatin1(d->data, v.data(), v.size());
+  else if(t == UTF8 && isValidUTF8(v.data(), v.size())) {
+    const char *end = static_cast<const char *>(::memchr(v.data(), '\0', v.size()));
+    d->utf8.assign(v.data(), end ? end - v.data() : v.size());
+    return;
+  }
   else if(t == UTF8)
     copyFromUTF8(d->data, v.data(), v.size());
   else
@@ -273,30 +479,39 @@ String::String(const ByteVector &v, Type t) :
 
 String::~String()
 {
-  if(d->deref())
+  if(d != StringPrivate::empty() && d->counter.deref())
     delete d;
 }
 
 std::string String::to8Bit(bool unicode) const
 {
+  if(unicode && !d->utf8.empty())
+    return d->utf8;
+
   const ByteVector v = data(unicode ? UTF8 : Latin1);
   return std::string(v.data(), v.size());
 }
 
 TagLib::wstring String::toWString() const
 {
-  return d->data;
+  return d->wide();
 }
 
 const char *String::toCString(bool unicode) const
 {
+  if(d == StringPrivate::empty())
+    return "";
+
+  if(unicode && !d->utf8.empty())
+    return d->utf8.c_str();
+
   d->cstring = to8Bit(unicode);
   return d->cstring.c_str();
 }
 
 const wchar_t *String::toCWString() const
 {
-  return d->data.c_str();
+  return d->wide().c_str();
 }
 
 String::Iterator String::begin()
@@ -307,7 +522,7 @@ String::Iterator String::begin()
 
 String::ConstIterator String::begin() const
 {
-  return d->data.begin();
+  return d->wide().begin();
 }
 
 String::Iterator String::end()
@@ -318,17 +533,17 @@ String::Iterator String::end()
 
 String::ConstIterator String::end() const
 {
-  return d->data.end();
+  return d->wide().end();
 }
 
 int String::find(const String &s, int offset) const
 {
-  return static_cast<int>(d->data.find(s.d->data, offset));
+  return static_cast<int>(d->wide().find(s.d->wide(), offset));
 }
 
 int String::rfind(const String &s, int offset) const
 {
-  return static_cast<int>(d->data.rfind(s.d->data, offset));
+  return static_cast<int>(d->wide().rfind(s.d->wide(), offset));
 }
 
 StringList String::split(const String &separator) const
@@ -361,13 +576,13 @@ String String::substr(unsigned int position, unsigned int n) const
   if(position == 0 && n >= size())
     return *this;
   else
-    return String(d->data.substr(position, n));
+    return String(d->wide().substr(position, n));
 }
 
 String &String::append(const String &s)
 {
   detach();
-  d->data += s.d->data;
+  d->data += s.d->wide();
   return *this;
 }
 
@@ -380,6 +595,7 @@ String & String::clear()
 String String::upper() const
 {
   String s;
+  s.detach();
   s.d->data.reserve(size());
 
   for(ConstIterator it = begin(); it != end(); ++it) {
@@ -394,6 +610,9 @@ String String::upper() const
 
 unsigned int String::size() const
 {
+  if(d->isPending())
+    return static_cast<unsigned int>(utf16Length(d->utf8));
+
   return static_cast<unsigned int>(d->data.size());
 }
 
@@ -404,7 +623,7 @@ unsigned int String::length() const
 
 bool String::isEmpty() const
 {
-  return d->data.empty();
+  return d->data.empty() && d->utf8.empty();
 }
 
 bool String::isNull() const
@@ -418,21 +637,53 @@ ByteVector String::data(Type t) const
   {
   case Latin1:
     {
-      ByteVector v(size(), 0);
+      const wstring &src = d->wide();
+      ByteVector v(static_cast<unsigned int>(src.size()), 0);
       char *p = v.data();
 
-      for(ConstIterator it = begin(); it != end(); ++it)
-        *p++ = static_cast<char>(*it);
+      for(size_t i = 0; i < src.size(); ++i)
+        p[i] = static_cast<char>(src[i]);
 
       return v;
     }
   case UTF8:
     {
-      ByteVector v(size() * 4, 0);
+      if(!d->utf8.empty())
+        return ByteVector(d->utf8.data(), static_cast<unsigned int>(d->utf8.size()));
+
+      const wstring &src = d->wide();
+      ByteVector v(static_cast<unsigned int>(src.size() * 3), 0);
+      if(src.empty())
+        return v;
+
+      const wchar_t *s = src.data();
+      const wchar_t *const end = s + src.size();
+      char *const begin = v.data();
+      char *dst = begin;
 
       try {
-        const ByteVector::Iterator dstEnd = utf8::utf16to8(begin(), end(), v.begin());
-        v.resize(static_cast<unsigned int>(dstEnd - v.begin()));
+        while(s < end) {
+          const size_t ascii = asciiLength(s, end - s);
+          for(size_t i = 0; i < ascii; ++i)
+            dst[i] = static_cast<char>(s[i]);
+
+          dst += ascii;
+          s   += ascii;
+          if(s == end)
+            break;
+
+          // Hand the following non-ASCII characters to UTF8-CPP together, so
+          // that surrogate pairs stay in one piece.
+
+          const wchar_t *run = s;
+          while(run < end && static_cast<unsigned int>(*run) >= 0x80)
+            ++run;
+
+          dst = utf8::utf16to8(s, run, dst);
+          s = run;
+        }
+
+        v.resize(static_cast<unsigned int>(dst - begin));
       }
       catch(const utf8::exception &e) {
         debug(String("String::data() - UTF8-CPP error: ") + e.what());
@@ -443,7 +694,8 @@ ByteVector String::data(Type t) const
     }
   case UTF16:
     {
-      ByteVector v(2 + size() * 2, 0);
+      const wstring &src = d->wide();
+      ByteVector v(static_cast<unsigned int>(2 + src.size() * 2), 0);
       char *p = v.data();
 
       // We use little-endian encoding here and need a BOM.
@@ -451,33 +703,35 @@ ByteVector String::data(Type t) const
       *p++ = '\xff';
       *p++ = '\xfe';
 
-      for(ConstIterator it = begin(); it != end(); ++it) {
-        *p++ = static_cast<char>(*it & 0xff);
-        *p++ = static_cast<char>(*it >> 8);
+      for(size_t i = 0; i < src.size(); ++i) {
+        p[i * 2]     = static_cast<char>(src[i] & 0xff);
+        p[i * 2 + 1] = static_cast<char>(src[i] >> 8);
       }
 
       return v;
     }
   case UTF16BE:
     {
-      ByteVector v(size() * 2, 0);
+      const wstring &src = d->wide();
+      ByteVector v(static_cast<unsigned int>(src.size() * 2), 0);
       char *p = v.data();
 
-      for(ConstIterator it = begin(); it != end(); ++it) {
-        *p++ = static_cast<char>(*it >> 8);
-        *p++ = static_cast<char>(*it & 0xff);
+      for(size_t i = 0; i < src.size(); ++i) {
+        p[i * 2]     = static_cast<char>(src[i] >> 8);
+        p[i * 2 + 1] = static_cast<char>(src[i] & 0xff);
       }
 
       return v;
     }
   case UTF16LE:
     {
-      ByteVector v(size() * 2, 0);
+      const wstring &src = d->wide();
+      ByteVector v(static_cast<unsigned int>(src.size() * 2), 0);
       char *p = v.data();
 
-      for(ConstIterator it = begin(); it != end(); ++it) {
-        *p++ = static_cast<char>(*it & 0xff);
-        *p++ = static_cast<char>(*it >> 8);
+      for(size_t i = 0; i < src.size(); ++i) {
+        p[i * 2]     = static_cast<char>(src[i] & 0xff);
+        p[i * 2 + 1] = static_cast<char>(src[i] >> 8);
       }
 
       return v;
@@ -497,7 +751,7 @@ int String::toInt() const
 
 int String::toInt(bool *ok) const
 {
-  const wchar_t *begin = d->data.c_str();
+  const wchar_t *begin = d->wide().c_str();
   wchar_t *end;
   errno = 0;
   const long value = ::wcstol(begin, &end, 10);
@@ -515,11 +769,11 @@ String String::stripWhiteSpace() const
 {
   static const wchar_t *WhiteSpaceChars = L"\t\n\f\r ";
 
-  const size_t pos1 = d->data.find_first_not_of(WhiteSpaceChars);
+  const size_t pos1 = d->wide().find_first_not_of(WhiteSpaceChars);
   if(pos1 == std::wstring::npos)
     return String();
 
-  const size_t pos2 = d->data.find_last_not_of(WhiteSpaceChars);
+  const size_t pos2 = d->wide().find_last_not_of(WhiteSpaceChars);
   return substr(static_cast<unsigned int>(pos1), static_cast<unsigned int>(pos2 - pos1 + 1));
 }
 
@@ -554,12 +808,20 @@ wchar_t &String::operator[](int i)
 
 const wchar_t &String::operator[](int i) const
 {
-  return d->data[i];
+  return d->wide()[i];
 }
 
 bool String::operator==(const String &s) const
 {
-  return (d == s.d || d->data == s.d->data);
+  if(d == s.d)
+    return true;
+
+  // Valid UTF-8 and UTF-16 encode the same strings in exactly one way each.
+
+  if(!d->utf8.empty() && !s.d->utf8.empty())
+    return (d->utf8 == s.d->utf8);
+
+  return (d->wide() == s.d->wide());
 }
 
 bool String::operator!=(const String &s) const
@@ -585,7 +847,7 @@ bool String::operator!=(const char *s) const
 
 bool String::operator==(const wchar_t *s) const
 {
-  return (d->data == s);
+  return (d->wide() == s);
 }
 
 bool String::operator!=(const wchar_t *s) const
@@ -597,7 +859,7 @@ String &String::operator+=(const String &s)
 {
   detach();
 
-  d->data += s.d->data;
+  d->data += s.d->wide();
   return *this;
 }
 
@@ -640,6 +902,16 @@ String &String::operator=(const String &s)
   return *this;
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+String &String::operator=(String &&s)
+{
+  String(std::move(s)).swap(*this);
+  return *this;
+}
+
+#endif
+
 String &String::operator=(const std::string &s)
 {
   String(s).swap(*this);
@@ -691,7 +963,7 @@ void String::swap(String &s)
 
 bool String::operator<(const String &s) const
 {
-  return (d->data < s.d->data);
+  return (d->wide() < s.d->wide());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -700,8 +972,19 @@ bool String::operator<(const String &s) const
 
 void String::detach()
 {
-  if(d->count() > 1)
-    String(d->data.c_str()).swap(*this);
+  if(d == StringPrivate::empty())
+    d = new StringPrivate();
+  else if(d->counter.count() > 1)
+    String(d->wide().c_str()).swap(*this);
+  else if(!d->utf8.empty()) {
+    TagLib::wstring *w = d->decoded.release();
+    if(w)
+      d->data.swap(*w);
+    else
+      copyFromUTF8(d->data, d->utf8.data(), d->utf8.size());
+    delete w;
+    d->utf8.clear();
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
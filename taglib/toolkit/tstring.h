@@ -79,6 +79,12 @@ namespace TagLib {
    *
    * In addition to adding implicit sharing, this class keeps track of four
    * possible encodings, which are the four supported by the ID3v2 standard.
+   *
+   * A string created from valid UTF-8 keeps the UTF-8 bytes and is only
+   * decoded when its UTF-16 form is needed, so that strings which are just
+   * passed through or written back as UTF-8 are never converted.  Copies of
+   * such a string copy the bytes rather than sharing them until it has been
+   * decoded.
    */
 
   class TAGLIB_EXPORT String
@@ -130,6 +136,14 @@ namespace TagLib {
      */
     String(const String &s);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Constructs a string that takes over the data of \a s.  \a s is left
+     * empty.
+     */
+    String(String &&s);
+#endif
+
     /*!
      * Makes a deep copy of the data in \a s.
      *
@@ -469,6 +483,13 @@ namespace TagLib {
      */
     String &operator=(const String &s);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Takes over the data of \a s.  \a s is left empty.
+     */
+    String &operator=(String &&s);
+#endif
+
     /*!
      * Performs a deep copy of the data in \a s.
      */
@@ -23,6 +23,8 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#include <utility>
+
 #include "tstringlist.h"
 
 using namespace TagLib;
@@ -65,6 +67,15 @@ StringList::StringList(const StringList &l) : List<String>(l)
 
 }
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+StringList::StringList(StringList &&l) : List<String>(std::move(l))
+{
+
+}
+
+#endif
+
 StringList::StringList(const String &s) : List<String>()
 {
   append(s);
@@ -83,6 +94,22 @@ StringList::~StringList()
 
 }
 
+StringList &StringList::operator=(const StringList &l)
+{
+  List<String>::operator=(l);
+  return *this;
+}
+
+#ifdef TAGLIB_MOVE_SEMANTICS
+
+StringList &StringList::operator=(StringList &&l)
+{
+  List<String>::operator=(std::move(l));
+  return *this;
+}
+
+#endif
+
 String StringList::toString(const String &separator) const
 {
   String s;
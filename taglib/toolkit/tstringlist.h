@@ -58,6 +58,14 @@ namespace TagLib {
      */
     StringList(const StringList &l);
 
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Constructs a StringList that takes over the strings of \a l.  \a l is
+     * left empty.
+     */
+    StringList(StringList &&l);
+#endif
+
     /*!
      * Constructs a StringList with \a s as a member.
      */
@@ -76,6 +84,18 @@ namespace TagLib {
      */
     virtual ~StringList();
 
+    /*!
+     * Make a shallow, implicitly shared, copy of \a l.
+     */
+    StringList &operator=(const StringList &l);
+
+#ifdef TAGLIB_MOVE_SEMANTICS
+    /*!
+     * Takes over the strings of \a l.  \a l is left empty.
+     */
+    StringList &operator=(StringList &&l);
+#endif
+
     /*!
      * Concatenate the list of strings into one string separated by \a separator.
      */
@@ -33,6 +33,7 @@
 #include <tagunion.h>
 #include <tstringlist.h>
 #include <tpropertymap.h>
+#include <tpropertyhandlers.h>
 #include <tagutils.h>
 
 #include "trueaudiofile.h"
@@ -81,6 +82,8 @@ TrueAudio::File::File(FileName file, bool readProperties, Properties::ReadStyle)
   TagLib::File(file),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -90,6 +93,8 @@ TrueAudio::File::File(FileName file, ID3v2::FrameFactory *frameFactory,
   TagLib::File(file),
   d(new FilePrivate(frameFactory))
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -98,6 +103,8 @@ TrueAudio::File::File(IOStream *stream, bool readProperties, Properties::ReadSty
   TagLib::File(stream),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -107,6 +114,8 @@ TrueAudio::File::File(IOStream *stream, ID3v2::FrameFactory *frameFactory,
   TagLib::File(stream),
   d(new FilePrivate(frameFactory))
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -156,6 +165,8 @@ bool TrueAudio::File::save()
     return false;
   }
 
+  SaveScope scope(this);
+
   // Update ID3v2 tag
 
   if(ID3v2Tag() && !ID3v2Tag()->isEmpty()) {
@@ -224,7 +235,12 @@ ID3v1::Tag *TrueAudio::File::ID3v1Tag(bool create)
 
 ID3v2::Tag *TrueAudio::File::ID3v2Tag(bool create)
 {
-  return d->tag.access<ID3v2::Tag>(TrueAudioID3v2Index, create);
+  // A new tag is bound to this file, so that its padding fits the file.
+
+  if(create && !d->tag[TrueAudioID3v2Index])
+    d->tag.set(TrueAudioID3v2Index, new ID3v2::Tag(this, -1, d->ID3v2FrameFactory));
+
+  return d->tag.access<ID3v2::Tag>(TrueAudioID3v2Index, false);
 }
 
 void TrueAudio::File::strip(int tags)
@@ -255,19 +271,15 @@ bool TrueAudio::File::hasID3v2Tag() const
 
 void TrueAudio::File::read(bool readProperties)
 {
-  // Look for an ID3v2 tag
+  // Look for ID3v2 and ID3v1 tags
 
-  d->ID3v2Location = Utils::findID3v2(this);
+  Utils::findTags(this, &d->ID3v2Location, &d->ID3v1Location, 0);
 
   if(d->ID3v2Location >= 0) {
     d->tag.set(TrueAudioID3v2Index, new ID3v2::Tag(this, d->ID3v2Location, d->ID3v2FrameFactory));
     d->ID3v2OriginalSize = ID3v2Tag()->header()->completeTagSize();
   }
 
-  // Look for an ID3v1 tag
-
-  d->ID3v1Location = Utils::findID3v1(this);
-
   if(d->ID3v1Location >= 0)
     d->tag.set(TrueAudioID3v1Index, new ID3v1::Tag(this, d->ID3v1Location));
 
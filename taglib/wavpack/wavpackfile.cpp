@@ -32,6 +32,7 @@
 #include <tdebug.h>
 #include <tagunion.h>
 #include <tpropertymap.h>
+#include <tpropertyhandlers.h>
 #include <tagutils.h>
 
 #include "wavpackfile.h"
@@ -79,6 +80,8 @@ WavPack::File::File(FileName file, bool readProperties, Properties::ReadStyle) :
   TagLib::File(file),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -87,6 +90,8 @@ WavPack::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle
   TagLib::File(stream),
   d(new FilePrivate())
 {
+  setPropertyHandlers(Utils::propertyHandlers<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -131,6 +136,8 @@ bool WavPack::File::save()
     return false;
   }
 
+  SaveScope scope(this);
+
   // Update ID3v1 tag
 
   if(ID3v1Tag() && !ID3v1Tag()->isEmpty()) {
@@ -234,17 +241,13 @@ bool WavPack::File::hasAPETag() const
 
 void WavPack::File::read(bool readProperties)
 {
-  // Look for an ID3v1 tag
+  // Look for ID3v1 and APE tags
 
-  d->ID3v1Location = Utils::findID3v1(this);
+  Utils::findTags(this, 0, &d->ID3v1Location, &d->APELocation);
 
   if(d->ID3v1Location >= 0)
     d->tag.set(WavID3v1Index, new ID3v1::Tag(this, d->ID3v1Location));
 
-  // Look for an APE tag
-
-  d->APELocation = Utils::findAPE(this, d->ID3v1Location);
-
   if(d->APELocation >= 0) {
     d->tag.set(WavAPEIndex, new APE::Tag(this, d->APELocation));
     d->APESize = APETag()->footer()->completeTagSize();
@@ -28,6 +28,7 @@
 #include "xmfile.h"
 #include "modfileprivate.h"
 #include "tpropertymap.h"
+#include "tpropertyhandlers.h"
 
 #include <string.h>
 #include <algorithm>
@@ -360,6 +361,8 @@ XM::File::File(FileName file, bool readProperties,
   Mod::FileBase(file),
   d(new FilePrivate(propertiesStyle))
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -369,6 +372,8 @@ XM::File::File(IOStream *stream, bool readProperties,
   Mod::FileBase(stream),
   d(new FilePrivate(propertiesStyle))
 {
+  setPropertyHandlers(Utils::propertyHandlersWithoutRemove<File>());
+
   if(isOpen())
     read(readProperties);
 }
@@ -405,6 +410,8 @@ bool XM::File::save()
     return false;
   }
 
+  SaveScope scope(this);
+
   seek(17);
   writeString(d->tag.title(), 20);
 
@@ -27,6 +27,8 @@
 #include <cmath>
 #include <tbytevector.h>
 #include <tbytevectorlist.h>
+#include <tbytereader.h>
+#include <utility>
 #include <cppunit/extensions/HelperMacros.h>
 
 using namespace std;
@@ -39,6 +41,7 @@ class TestByteVector : public CppUnit::TestFixture
   CPPUNIT_TEST(testFind1);
   CPPUNIT_TEST(testFind2);
   CPPUNIT_TEST(testFind3);
+  CPPUNIT_TEST(testFind4);
   CPPUNIT_TEST(testRfind1);
   CPPUNIT_TEST(testRfind2);
   CPPUNIT_TEST(testRfind3);
@@ -52,6 +55,11 @@ class TestByteVector : public CppUnit::TestFixture
   CPPUNIT_TEST(testAppend1);
   CPPUNIT_TEST(testAppend2);
   CPPUNIT_TEST(testBase64);
+  CPPUNIT_TEST(testEmptyAndMove);
+  CPPUNIT_TEST(testSharing);
+  CPPUNIT_TEST(testChecksum);
+  CPPUNIT_TEST(testBase64Long);
+  CPPUNIT_TEST(testReader);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -122,6 +130,36 @@ public:
     CPPUNIT_ASSERT_EQUAL(-1, ByteVector("....SggO."). find('S', 8));
   }
 
+  void testFind4()
+  {
+    // Long patterns, and patterns whose prefix occurs before the match.
+
+    const ByteVector pattern("0123456789ABCDEF0123456789abcdef");
+    ByteVector data(100, '0');
+    data.append("0123456789ABCDEF0123456789abcdeF");
+    data.append(pattern);
+    data.append(ByteVector(100, '0'));
+    data.append(pattern);
+
+    CPPUNIT_ASSERT_EQUAL(132, data.find(pattern));
+    CPPUNIT_ASSERT_EQUAL(132, data.find(pattern, 132));
+    CPPUNIT_ASSERT_EQUAL(264, data.find(pattern, 133));
+    CPPUNIT_ASSERT_EQUAL(-1, data.find(pattern, 265));
+    CPPUNIT_ASSERT_EQUAL(264, data.find(pattern, 0, 8));
+    CPPUNIT_ASSERT_EQUAL(-1, data.find(pattern, 0, 7));
+    CPPUNIT_ASSERT_EQUAL(264, data.rfind(pattern));
+    CPPUNIT_ASSERT_EQUAL(132, data.rfind(pattern, 263));
+
+    CPPUNIT_ASSERT_EQUAL(100, data.find("0123"));
+    CPPUNIT_ASSERT_EQUAL(100, data.find("012345678"));
+    CPPUNIT_ASSERT_EQUAL(126, data.find("abcdeF"));
+    CPPUNIT_ASSERT_EQUAL(290, data.rfind("abcdef"));
+    CPPUNIT_ASSERT_EQUAL(158, data.rfind("abcdef", 289));
+    CPPUNIT_ASSERT_EQUAL(-1, data.find(ByteVector()));
+    CPPUNIT_ASSERT_EQUAL(-1, ByteVector().find('0'));
+    CPPUNIT_ASSERT_EQUAL(-1, ByteVector().rfind("0"));
+  }
+
   void testRfind1()
   {
     CPPUNIT_ASSERT_EQUAL(1, ByteVector(".OggS....").rfind("OggS", 0));
@@ -594,6 +632,163 @@ public:
 
   }
 
+  void testEmptyAndMove()
+  {
+    ByteVector v1;
+    ByteVector v2;
+    v1.append('a');
+    CPPUNIT_ASSERT_EQUAL(ByteVector("a"), v1);
+    CPPUNIT_ASSERT(v2.isEmpty());
+    CPPUNIT_ASSERT(!v2.isNull());
+
+    v2.resize(2, 'b');
+    CPPUNIT_ASSERT_EQUAL(ByteVector("bb"), v2);
+    CPPUNIT_ASSERT(ByteVector().isEmpty());
+
+    ByteVector v3 = v2;
+    v3.clear();
+    CPPUNIT_ASSERT(v3.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(ByteVector("bb"), v2);
+
+#ifdef TAGLIB_MOVE_SEMANTICS
+    ByteVector v4(std::move(v2));
+    CPPUNIT_ASSERT_EQUAL(ByteVector("bb"), v4);
+    CPPUNIT_ASSERT(v2.isEmpty());
+
+    v2.append('c');
+    CPPUNIT_ASSERT_EQUAL(ByteVector("c"), v2);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("bb"), v4);
+
+    v3 = std::move(v4);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("bb"), v3);
+    CPPUNIT_ASSERT(v4.isEmpty());
+
+    v4.append(ByteVector("de"));
+    v4.append(ByteVector("f"));
+    CPPUNIT_ASSERT_EQUAL(ByteVector("def"), v4);
+#endif
+  }
+
+  void testSharing()
+  {
+    ByteVector a("0123456789");
+    ByteVector b = a;
+    ByteVector c = a.mid(2, 4);
+    ByteVector d = c.mid(1, 2);
+    const ByteVector &ca = a;
+    const ByteVector &cb = b;
+    CPPUNIT_ASSERT_EQUAL(ca.data(), cb.data());
+
+    b[0] = 'x';
+    c[0] = 'y';
+    CPPUNIT_ASSERT_EQUAL(ByteVector("0123456789"), a);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("x123456789"), b);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("y345"), c);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("34"), d);
+
+    a.resize(3);
+    a.clear();
+    d.append('z');
+    CPPUNIT_ASSERT_EQUAL(ByteVector("34z"), d);
+    d.resize(1);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("3"), d);
+
+    ByteVector e = ByteVector("abcdef").mid(2);
+    e[0] = 'C';
+    e.append("gh");
+    CPPUNIT_ASSERT_EQUAL(ByteVector("Cdefgh"), e);
+  }
+
+  void testChecksum()
+  {
+    ByteVector data(300, '\0');
+    unsigned int seed = 1;
+    for(unsigned int i = 0; i < data.size(); ++i) {
+      seed = seed * 1103515245 + 12345;
+      data[i] = static_cast<char>(seed >> 16);
+    }
+
+    // Compare with the CRC computed bit by bit at different lengths and
+    // alignments.
+
+    for(unsigned int offset = 0; offset < 8; ++offset) {
+      for(unsigned int length = 0; offset + length <= data.size(); length += 7) {
+        const ByteVector v = data.mid(offset, length);
+
+        unsigned int crc = 0;
+        for(unsigned int i = 0; i < v.size(); ++i) {
+          crc ^= static_cast<unsigned int>(static_cast<unsigned char>(v[i])) << 24;
+          for(int bit = 0; bit < 8; ++bit)
+            crc = (crc & 0x80000000) ? ((crc << 1) ^ 0x04c11db7) : (crc << 1);
+        }
+
+        CPPUNIT_ASSERT_EQUAL(crc, v.checksum());
+      }
+    }
+  }
+
+  void testBase64Long()
+  {
+    ByteVector data(1000, '\0');
+    for(unsigned int i = 0; i < data.size(); ++i)
+      data[i] = static_cast<char>(i * 37 + (i >> 3));
+
+    for(unsigned int length = 990; length <= 1000; ++length) {
+      const ByteVector v = data.mid(0, length);
+      CPPUNIT_ASSERT_EQUAL(v, ByteVector::fromBase64(v.toBase64()));
+    }
+
+    const ByteVector e = data.toBase64();
+    CPPUNIT_ASSERT_EQUAL(ByteVector("ACVK"), e.mid(0, 4));
+
+    ByteVector invalid = e;
+    invalid[600] = '.';
+    CPPUNIT_ASSERT(ByteVector::fromBase64(invalid).isEmpty());
+
+    ByteVector padded = e;
+    padded[603] = '=';
+    CPPUNIT_ASSERT(ByteVector::fromBase64(padded).isEmpty());
+  }
+
+  void testReader()
+  {
+    const ByteVector data("\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10"
+                          "\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f\x20"
+                          "ABCD", 36);
+
+    Utils::ByteReader reader(data);
+    CPPUNIT_ASSERT_EQUAL((unsigned char)0x01, reader.readByte());
+    CPPUNIT_ASSERT_EQUAL((unsigned short)0x0203, reader.readUShort());
+    CPPUNIT_ASSERT_EQUAL((unsigned short)0x0504, reader.readUShort(false));
+    CPPUNIT_ASSERT_EQUAL(0x060708U, reader.readUInt24());
+    CPPUNIT_ASSERT_EQUAL(0x0b0a09U, reader.readUInt24(false));
+    CPPUNIT_ASSERT_EQUAL(0x0c0d0e0fU, reader.readUInt());
+    CPPUNIT_ASSERT_EQUAL(0x13121110U, reader.readUInt(false));
+    CPPUNIT_ASSERT_EQUAL(0x1415161718191a1bULL, reader.readULongLong());
+    CPPUNIT_ASSERT(reader.skip(5));
+    CPPUNIT_ASSERT_EQUAL((size_t)32, reader.position());
+    CPPUNIT_ASSERT(reader.startsWith("AB", 2));
+    CPPUNIT_ASSERT(!reader.startsWith("ABCDE", 5));
+    CPPUNIT_ASSERT_EQUAL(ByteVector("ABC"), reader.readBlock(3));
+    CPPUNIT_ASSERT(reader.isValid());
+
+    // Reads past the end fail without moving the cursor.
+    CPPUNIT_ASSERT_EQUAL(0U, reader.readUInt());
+    CPPUNIT_ASSERT(!reader.isValid());
+    CPPUNIT_ASSERT_EQUAL((size_t)35, reader.position());
+    CPPUNIT_ASSERT(reader.readBlock(2).isEmpty());
+    CPPUNIT_ASSERT(!reader.skip(2));
+    CPPUNIT_ASSERT_EQUAL('D', static_cast<char>(reader.readByte()));
+    CPPUNIT_ASSERT(reader.atEnd());
+    CPPUNIT_ASSERT(!reader.seek(37));
+    CPPUNIT_ASSERT(reader.seek(0));
+
+    Utils::ByteReader raw(data.data() + 32, 4);
+    CPPUNIT_ASSERT_EQUAL(0x41424344U, raw.readUInt());
+    CPPUNIT_ASSERT(raw.isValid());
+    CPPUNIT_ASSERT(raw.atEnd());
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestByteVector);
@@ -39,6 +39,7 @@ class TestByteVectorStream : public CppUnit::TestFixture
   CPPUNIT_TEST(testRemoveBlock);
   CPPUNIT_TEST(testInsert);
   CPPUNIT_TEST(testSeekEnd);
+  CPPUNIT_TEST(testReadBlocks);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -126,6 +127,33 @@ public:
     CPPUNIT_ASSERT_EQUAL(ByteVector("b"), stream.readBlock(1));
   }
 
+  void testReadBlocks()
+  {
+    ByteVector v("abcdefghijklmnopqrstuvwxyz");
+    ByteVectorStream stream(v);
+    stream.seek(5);
+
+    List<IOStream::Range> ranges;
+    ranges.append(IOStream::Range(-3, 3));
+    ranges.append(IOStream::Range(0, 2));
+    ranges.append(IOStream::Range(1, 3));
+    ranges.append(IOStream::Range(24, 10));
+    ranges.append(IOStream::Range(-30, 3));
+    ranges.append(IOStream::Range(30, 3));
+    ranges.append(IOStream::Range(10, 0));
+
+    const ByteVectorList blocks = stream.readBlocks(ranges);
+    CPPUNIT_ASSERT_EQUAL(7U, blocks.size());
+    CPPUNIT_ASSERT_EQUAL(ByteVector("xyz"), blocks[0]);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("ab"), blocks[1]);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("bcd"), blocks[2]);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("yz"), blocks[3]);
+    CPPUNIT_ASSERT(blocks[4].isEmpty());
+    CPPUNIT_ASSERT(blocks[5].isEmpty());
+    CPPUNIT_ASSERT(blocks[6].isEmpty());
+    CPPUNIT_ASSERT_EQUAL(5L, stream.tell());
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestByteVectorStream);
@@ -24,6 +24,16 @@
  ***************************************************************************/
 
 #include <tfile.h>
+#include <tfilestream.h>
+#include <tpropertymap.h>
+#include <mpegfile.h>
+#include <id3v1tag.h>
+#include <id3v2tag.h>
+#include <apetag.h>
+#include <modfile.h>
+#include <mp4file.h>
+#include <fileref.h>
+#include <tag.h>
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
 
@@ -37,6 +47,23 @@ public:
   AudioProperties *audioProperties() const { return NULL; }
   bool save(){ return false; }
   void truncate(long length) { File::truncate(length); }
+
+  // Replaces the first and the last ten bytes with \a head and \a tail and
+  // then overwrites the first byte, all as one save.  Returns the contents
+  // of the file on the disk before the save ends.
+
+  ByteVector save(const ByteVector &head, const ByteVector &tail)
+  {
+    SaveScope scope(this);
+
+    insert(head, 0, 10);
+    insert(tail, length() - 10, 10);
+    seek(0);
+    writeBlock("X");
+
+    FileStream stream(name(), true);
+    return stream.readBlock(stream.length());
+  }
 };
 
 class TestFile : public CppUnit::TestFixture
@@ -44,8 +71,17 @@ class TestFile : public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(TestFile);
   CPPUNIT_TEST(testFindInSmallFile);
   CPPUNIT_TEST(testRFindInSmallFile);
+  CPPUNIT_TEST(testRFindAcrossBuffers);
   CPPUNIT_TEST(testSeek);
   CPPUNIT_TEST(testTruncate);
+  CPPUNIT_TEST(testLength);
+  CPPUNIT_TEST(testInsertAndRemove);
+  CPPUNIT_TEST(testInsertAndRemoveBlocks);
+  CPPUNIT_TEST(testReplaceFile);
+  CPPUNIT_TEST(testReplaceFileOncePerSave);
+  CPPUNIT_TEST(testReplaceFileMP4);
+  CPPUNIT_TEST(testReplaceFileMPEG);
+  CPPUNIT_TEST(testPropertyHandlers);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -106,6 +142,38 @@ public:
     }
   }
 
+  void testRFindAcrossBuffers()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+    std::string name = copy.fileName();
+    {
+      PlainFile file(name.c_str());
+      file.seek(0);
+      file.writeBlock(ByteVector(100000, '-'));
+      file.seek(100000 - 1022);
+      file.writeBlock("OggS");
+      file.seek(30000);
+      file.writeBlock("fLaC");
+      file.seek(40000);
+      file.writeBlock("ID3");
+    }
+    {
+      PlainFile file(name.c_str());
+      CPPUNIT_ASSERT_EQUAL(100000L, file.length());
+
+      // Matches that straddle the blocks read backwards.
+
+      CPPUNIT_ASSERT_EQUAL(100000L - 1022, file.rfind("OggS"));
+      CPPUNIT_ASSERT_EQUAL(100000L - 1022, file.rfind("OggS", 100000 - 1022));
+      CPPUNIT_ASSERT_EQUAL(-1L, file.rfind("OggS", 100000 - 1023));
+      CPPUNIT_ASSERT_EQUAL(30000L, file.rfind("fLaC"));
+      CPPUNIT_ASSERT_EQUAL(30000L, file.rfind("fLaC", 50000));
+      CPPUNIT_ASSERT_EQUAL(-1L, file.rfind("fLaC", 50000, "ID3"));
+      CPPUNIT_ASSERT_EQUAL(30000L, file.rfind("fLaC", 39000, "ID3"));
+      CPPUNIT_ASSERT_EQUAL(0L, file.tell());
+    }
+  }
+
   void testSeek()
   {
     ScopedFileCopy copy("empty", ".ogg");
@@ -148,7 +216,297 @@ public:
     }
   }
 
+  void testLength()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+    std::string name = copy.fileName();
+
+    {
+      PlainFile f(name.c_str());
+      CPPUNIT_ASSERT_EQUAL(4328L, f.length());
+
+      f.seek(4300);
+      f.writeBlock(ByteVector(10, 'x'));
+      CPPUNIT_ASSERT_EQUAL(4328L, f.length());
+
+      f.seek(0, File::End);
+      f.writeBlock(ByteVector(100, 'x'));
+      CPPUNIT_ASSERT_EQUAL(4428L, f.length());
+
+      f.insert(ByteVector(2000, 'y'), 10, 20);
+      CPPUNIT_ASSERT_EQUAL(6408L, f.length());
+
+      f.insert(ByteVector(10, 'y'), 10, 20);
+      CPPUNIT_ASSERT_EQUAL(6398L, f.length());
+
+      f.removeBlock(1000, 1500);
+      CPPUNIT_ASSERT_EQUAL(4898L, f.length());
+
+      f.truncate(3000);
+      CPPUNIT_ASSERT_EQUAL(3000L, f.length());
+
+      f.seek(-10, File::End);
+      CPPUNIT_ASSERT_EQUAL(10U, f.readBlock(1024).size());
+    }
+    {
+      PlainFile f(name.c_str());
+      CPPUNIT_ASSERT_EQUAL(3000L, f.length());
+    }
+  }
+
+  void testInsertAndRemove()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+    std::string name = copy.fileName();
+
+    ByteVector data;
+    for(int i = 0; i < 100000; ++i)
+      data.append(static_cast<char>(i % 251));
+
+    {
+      FileStream stream(name.c_str());
+      stream.writeBlock(data);
+      stream.truncate(data.size());
+    }
+
+    // A tiny buffer size forces many steps, the default one grows its
+    // buffer to move everything at once.
+
+    const unsigned int bufferSizes[] = { 7, 0 };
+    for(size_t i = 0; i < 2; ++i) {
+      FileStream stream(name.c_str(), false, bufferSizes[i]);
+
+      stream.insert(ByteVector(3000, 'x'), 10, 100);
+      ByteVector expected = data.mid(0, 10) + ByteVector(3000, 'x') + data.mid(110);
+      stream.seek(0);
+      CPPUNIT_ASSERT_EQUAL(expected, stream.readBlock(stream.length()));
+
+      stream.removeBlock(10, 3000);
+      expected = data.mid(0, 10) + data.mid(110);
+      stream.seek(0);
+      CPPUNIT_ASSERT_EQUAL(expected, stream.readBlock(stream.length()));
+
+      stream.insert(data.mid(10, 100), 10);
+      stream.seek(0);
+      CPPUNIT_ASSERT_EQUAL(data, stream.readBlock(stream.length()));
+    }
+  }
+
+  void testInsertAndRemoveBlocks()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+    std::string name = copy.fileName();
+
+    ByteVector data;
+    for(int i = 0; i < 100000; ++i)
+      data.append(static_cast<char>(i % 251));
+
+    FileStream stream(name.c_str());
+    stream.writeBlock(data);
+    stream.truncate(data.size());
+
+    // Changes by whole blocks may be done without moving the rest of the file.
+
+    stream.insert(ByteVector(8292, 'x'), 10, 100);
+    ByteVector expected = data.mid(0, 10) + ByteVector(8292, 'x') + data.mid(110);
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(expected.size()), stream.length());
+    stream.seek(0);
+    CPPUNIT_ASSERT_EQUAL(expected, stream.readBlock(stream.length()));
+
+    stream.insert(ByteVector(100, 'y'), 10, 4196);
+    expected = data.mid(0, 10) + ByteVector(100, 'y') + ByteVector(4096, 'x') + data.mid(110);
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(expected.size()), stream.length());
+    stream.seek(0);
+    CPPUNIT_ASSERT_EQUAL(expected, stream.readBlock(stream.length()));
+
+    stream.removeBlock(4096, 4096);
+    expected = expected.mid(0, 4096) + expected.mid(8192);
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(expected.size()), stream.length());
+    stream.seek(0);
+    CPPUNIT_ASSERT_EQUAL(expected, stream.readBlock(stream.length()));
+  }
+
+  void testReplaceFile()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+    std::string name = copy.fileName();
+
+    ByteVector data;
+    for(int i = 0; i < 100000; ++i)
+      data.append(static_cast<char>(i % 251));
+
+    {
+      PlainFile file(name.c_str());
+      file.writeBlock(data);
+      file.truncate(data.size());
+    }
+    {
+      PlainFile file(name.c_str());
+      CPPUNIT_ASSERT_EQUAL(File::InPlace, file.saveStrategy());
+      file.setSaveStrategy(File::ReplaceFile);
+      CPPUNIT_ASSERT_EQUAL(File::ReplaceFile, file.saveStrategy());
+
+      file.insert(ByteVector(3000, 'x'), 10, 100);
+      ByteVector expected = data.mid(0, 10) + ByteVector(3000, 'x') + data.mid(110);
+      CPPUNIT_ASSERT_EQUAL(static_cast<long>(expected.size()), file.length());
+      file.seek(0);
+      CPPUNIT_ASSERT_EQUAL(expected, file.readBlock(file.length()));
+
+      // The file is still usable after it has been replaced.
+
+      file.removeBlock(10, 3000);
+      file.insert(data.mid(10, 100), 10);
+      file.seek(0);
+      CPPUNIT_ASSERT_EQUAL(data, file.readBlock(file.length()));
+    }
+    {
+      PlainFile file(name.c_str());
+      CPPUNIT_ASSERT_EQUAL(static_cast<long>(data.size()), file.length());
+      CPPUNIT_ASSERT_EQUAL(data, file.readBlock(file.length()));
+    }
+  }
+
+  void testReplaceFileOncePerSave()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+    std::string name = copy.fileName();
+
+    ByteVector data;
+    for(int i = 0; i < 100000; ++i)
+      data.append(static_cast<char>(i % 251));
+
+    {
+      PlainFile file(name.c_str());
+      file.writeBlock(data);
+      file.truncate(data.size());
+    }
+
+    const ByteVector head(3000, 'h');
+    const ByteVector tail(20, 't');
+    const ByteVector expected = ByteVector("X") + head.mid(1) + data.mid(10, data.size() - 20) + tail;
+
+    {
+      PlainFile file(name.c_str());
+      file.setSaveStrategy(File::ReplaceFile);
+      const ByteVector during = file.save(head, tail);
+
+#ifdef HAVE_PREAD
+      // Nothing reaches the file before the save is done.
+
+      CPPUNIT_ASSERT_EQUAL(data, during);
+#endif
+
+      FileStream stream(name.c_str(), true);
+      CPPUNIT_ASSERT_EQUAL(expected, stream.readBlock(stream.length()));
+
+      file.seek(0);
+      CPPUNIT_ASSERT_EQUAL(expected, file.readBlock(file.length()));
+    }
+  }
+
+  void testReplaceFileMP4()
+  {
+    ScopedFileCopy copy("has-tags", ".m4a");
+
+    MP4::File f(copy.fileName().c_str());
+    f.setSaveStrategy(File::ReplaceFile);
+    f.tag()->setTitle(String(std::string(5000, 'x')));
+    CPPUNIT_ASSERT(f.save());
+
+    // The file is replaced when save() returns, not when f is destroyed.
+
+    MP4::File f2(copy.fileName().c_str());
+    CPPUNIT_ASSERT(f2.isValid());
+    CPPUNIT_ASSERT_EQUAL(String(std::string(5000, 'x')), f2.tag()->title());
+  }
+
+  void testReplaceFileMPEG()
+  {
+    ScopedFileCopy copy1("xing", ".mp3");
+    ScopedFileCopy copy2("xing", ".mp3");
+
+    for(int i = 0; i < 2; ++i) {
+      MPEG::File f((i == 0 ? copy1 : copy2).fileName().c_str());
+      if(i == 1)
+        f.setSaveStrategy(File::ReplaceFile);
+
+      f.ID3v2Tag(true)->setTitle(String(std::string(5000, 'x')));
+      f.APETag(true)->setArtist("Artist");
+      f.ID3v1Tag(true)->setAlbum("Album");
+      CPPUNIT_ASSERT(f.save(MPEG::File::AllTags));
+    }
+
+    FileStream stream1(copy1.fileName().c_str(), true);
+    FileStream stream2(copy2.fileName().c_str(), true);
+    CPPUNIT_ASSERT_EQUAL(stream1.length(), stream2.length());
+    CPPUNIT_ASSERT(stream1.readBlock(stream1.length()) == stream2.readBlock(stream2.length()));
+  }
+
+  void testPropertyHandlers()
+  {
+    ScopedFileCopy copy("rare_frames", ".mp3");
+    {
+      MPEG::File f(copy.fileName().c_str());
+      File &file = f;
+      CPPUNIT_ASSERT_EQUAL(f.properties().toString(), file.properties().toString());
+      CPPUNIT_ASSERT(!file.properties().unsupportedData().isEmpty());
+
+      file.removeUnsupportedProperties(file.properties().unsupportedData());
+      CPPUNIT_ASSERT(f.properties().unsupportedData().isEmpty());
+
+      PropertyMap tags;
+      tags["TITLE"] = String("Title");
+      CPPUNIT_ASSERT(file.setProperties(tags).isEmpty());
+      CPPUNIT_ASSERT_EQUAL(String("Title"), f.tag()->title());
+    }
+    {
+      Mod::File f(TEST_FILE_PATH_C("test.mod"));
+      File &file = f;
+      CPPUNIT_ASSERT_EQUAL(f.properties().toString(), file.properties().toString());
+      file.removeUnsupportedProperties(StringList("UNKNOWN"));
+      CPPUNIT_ASSERT_EQUAL(f.properties().toString(), file.properties().toString());
+    }
+
+    // Every format that registers handlers must survive all three calls
+    // through the base class.
+
+    const char *const files[][2] = {
+      { "silence-1",         ".wma"  },
+      { "click",             ".mpc"  },
+      { "empty",             ".ogg"  },
+      { "empty_flac",        ".oga"  },
+      { "correctness_gain_silent_output", ".opus" },
+      { "empty",             ".spx"  },
+      { "click",             ".wv"   },
+      { "has-tags",          ".m4a"  },
+      { "empty",             ".wav"  },
+      { "empty",             ".aiff" },
+      { "no-tags",           ".flac" },
+      { "rare_frames",       ".mp3"  },
+      { "mac-399",           ".ape"  },
+      { "empty",             ".tta"  },
+      { "test",              ".mod"  },
+      { "test",              ".s3m"  },
+      { "test",              ".it"   },
+      { "test",              ".xm"   }
+    };
+
+    for(size_t i = 0; i < sizeof(files) / sizeof(files[0]); ++i) {
+      ScopedFileCopy c(files[i][0], files[i][1]);
+      FileRef ref(c.fileName().c_str());
+      CPPUNIT_ASSERT(!ref.isNull());
+
+      File &file = *ref.file();
+      PropertyMap tags = file.properties();
+      file.removeUnsupportedProperties(tags.unsupportedData());
+      file.removeUnsupportedProperties(StringList("UNKNOWN"));
+
+      tags["TITLE"] = String("Title");
+      file.setProperties(tags);
+      CPPUNIT_ASSERT_EQUAL(String("Title"), file.properties()["TITLE"].front());
+    }
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestFile);
-
@@ -42,6 +42,7 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
 #include <tfilestream.h>
+#include <tbytevectorstream.h>
 
 using namespace std;
 using namespace TagLib;
@@ -79,6 +80,7 @@ class TestFileRef : public CppUnit::TestFixture
   CPPUNIT_TEST(testAIFF_1);
   CPPUNIT_TEST(testAIFF_2);
   CPPUNIT_TEST(testUnsupported);
+  CPPUNIT_TEST(testCreateByContent);
   CPPUNIT_TEST(testFileResolver);
   CPPUNIT_TEST_SUITE_END();
 
@@ -141,6 +143,18 @@ public:
       CPPUNIT_ASSERT_EQUAL(f.tag()->track(), (unsigned int)7);
       CPPUNIT_ASSERT_EQUAL(f.tag()->year(), (unsigned int)2080);
     }
+    {
+      FileRef f(newname.c_str(), true, AudioProperties::Average, true);
+      CPPUNIT_ASSERT(dynamic_cast<T*>(f.file()));
+      CPPUNIT_ASSERT(!f.isNull());
+      CPPUNIT_ASSERT(f.file()->readOnly());
+      CPPUNIT_ASSERT_EQUAL(f.tag()->artist(), String("ttest artist"));
+      CPPUNIT_ASSERT_EQUAL(f.tag()->title(), String("ytest title"));
+      CPPUNIT_ASSERT_EQUAL(f.tag()->genre(), String("uTest!"));
+      CPPUNIT_ASSERT_EQUAL(f.tag()->album(), String("ialbummmm"));
+      CPPUNIT_ASSERT_EQUAL(f.tag()->track(), (unsigned int)7);
+      CPPUNIT_ASSERT_EQUAL(f.tag()->year(), (unsigned int)2080);
+    }
   }
 
   void testMusepack()
@@ -237,6 +251,44 @@ public:
     CPPUNIT_ASSERT(f2.isNull());
   }
 
+  template <typename T>
+  void fileRefByContent(const char *fileName)
+  {
+    ByteVector data;
+    {
+      FileStream fs(fileName, true);
+      data = fs.readBlock(fs.length());
+    }
+
+    // A ByteVectorStream has no name, so there is no extension to go by.
+
+    ByteVectorStream stream(data);
+    FileRef f(&stream);
+    CPPUNIT_ASSERT(dynamic_cast<T *>(f.file()));
+    CPPUNIT_ASSERT(!f.isNull());
+  }
+
+  void testCreateByContent()
+  {
+    fileRefByContent<MPEG::File>(TEST_FILE_PATH_C("xing.mp3"));
+    fileRefByContent<MPEG::File>(TEST_FILE_PATH_C("id3v22-tda.mp3"));
+    fileRefByContent<FLAC::File>(TEST_FILE_PATH_C("no-tags.flac"));
+    fileRefByContent<Ogg::Vorbis::File>(TEST_FILE_PATH_C("empty_vorbis.oga"));
+    fileRefByContent<Ogg::FLAC::File>(TEST_FILE_PATH_C("empty_flac.oga"));
+    fileRefByContent<Ogg::Speex::File>(TEST_FILE_PATH_C("empty.spx"));
+    fileRefByContent<MPC::File>(TEST_FILE_PATH_C("click.mpc"));
+    fileRefByContent<TrueAudio::File>(TEST_FILE_PATH_C("empty.tta"));
+    fileRefByContent<MP4::File>(TEST_FILE_PATH_C("has-tags.m4a"));
+    fileRefByContent<ASF::File>(TEST_FILE_PATH_C("silence-1.wma"));
+    fileRefByContent<RIFF::AIFF::File>(TEST_FILE_PATH_C("alaw.aifc"));
+    fileRefByContent<RIFF::WAV::File>(TEST_FILE_PATH_C("empty.wav"));
+    fileRefByContent<APE::File>(TEST_FILE_PATH_C("mac-399-id3v2.ape"));
+
+    ByteVectorStream stream(ByteVector(1024, '\0'));
+    FileRef f(&stream);
+    CPPUNIT_ASSERT(f.isNull());
+  }
+
   void testFileResolver()
   {
     {
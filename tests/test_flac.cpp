@@ -250,9 +250,10 @@ public:
     FLAC::File f(copy.fileName().c_str());
     f.ID3v2Tag(true)->setTitle("0123456789");
     f.save();
-    CPPUNIT_ASSERT_EQUAL(5735L, f.length());
+    const long expected = alignedLength(4692, 5735, f.resizeAlignment());
+    CPPUNIT_ASSERT_EQUAL(expected, f.length());
     f.save();
-    CPPUNIT_ASSERT_EQUAL(5735L, f.length());
+    CPPUNIT_ASSERT_EQUAL(expected, f.length());
     CPPUNIT_ASSERT(f.find("fLaC") >= 0);
   }
 
@@ -263,9 +264,10 @@ public:
     FLAC::File f(copy.fileName().c_str());
     f.xiphComment()->setTitle(longText(8 * 1024));
     f.save();
-    CPPUNIT_ASSERT_EQUAL(12862L, f.length());
+    const long expected = alignedLength(4692, 12862, f.resizeAlignment());
+    CPPUNIT_ASSERT_EQUAL(expected, f.length());
     f.save();
-    CPPUNIT_ASSERT_EQUAL(12862L, f.length());
+    CPPUNIT_ASSERT_EQUAL(expected, f.length());
   }
 
   void testSaveMultipleValues()
@@ -45,6 +45,7 @@
 #include <tdebug.h>
 #include <tpropertymap.h>
 #include <tzlib.h>
+#include <tbytevectorstream.h>
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
 
@@ -63,6 +64,12 @@ class PublicFrame : public ID3v2::Frame
     virtual ByteVector renderFields() const { return ByteVector(); }
 };
 
+class LazyFrameFactory : public ID3v2::FrameFactory
+{
+  public:
+    LazyFrameFactory() { setLazyParsing(true); }
+};
+
 class TestID3v2 : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(TestID3v2);
@@ -120,6 +127,7 @@ class TestID3v2 : public CppUnit::TestFixture
   CPPUNIT_TEST(testEmptyFrame);
   CPPUNIT_TEST(testDuplicateTags);
   CPPUNIT_TEST(testParseTOCFrameWithManyChildren);
+  CPPUNIT_TEST(testLazyParsing);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -1184,7 +1192,7 @@ public:
     {
       MPEG::File f(newname.c_str());
       CPPUNIT_ASSERT(f.hasID3v2Tag());
-      CPPUNIT_ASSERT_EQUAL(74789L, f.length());
+      CPPUNIT_ASSERT_EQUAL(alignedLength(8208, 74789, f.resizeAlignment()), f.length());
       f.ID3v2Tag()->setTitle("ABCDEFGHIJ");
       f.save(MPEG::File::ID3v2, true);
     }
@@ -1266,6 +1274,97 @@ public:
     CPPUNIT_ASSERT(f.isValid());
   }
 
+  void testLazyParsing()
+  {
+    ID3v2::Tag tag;
+    tag.setTitle("Title");
+
+    ID3v2::AttachedPictureFrame *apic = new ID3v2::AttachedPictureFrame();
+    apic->setMimeType("image/png");
+    apic->setDescription("Cover");
+    apic->setPicture("picture data");
+    tag.addFrame(apic);
+
+    ID3v2::GeneralEncapsulatedObjectFrame *geob = new ID3v2::GeneralEncapsulatedObjectFrame();
+    geob->setFileName("notes.txt");
+    geob->setObject("object data");
+    tag.addFrame(geob);
+
+    ID3v2::SynchronizedLyricsFrame *sylt = new ID3v2::SynchronizedLyricsFrame();
+    ID3v2::SynchronizedLyricsFrame::SynchedTextList lines;
+    lines.append(ID3v2::SynchronizedLyricsFrame::SynchedText(0, "first"));
+    lines.append(ID3v2::SynchronizedLyricsFrame::SynchedText(1000, "second"));
+    sylt->setSynchedText(lines);
+    tag.addFrame(sylt);
+
+    ID3v2::TextIdentificationFrame *chapterTitle = new ID3v2::TextIdentificationFrame("TIT2");
+    chapterTitle->setText("Chapter 1");
+    ID3v2::FrameList embeddedFrames;
+    embeddedFrames.append(chapterTitle);
+    tag.addFrame(new ID3v2::ChapterFrame("C1", 0, 1000, 0xffffffff, 0xffffffff, embeddedFrames));
+    ByteVectorList children;
+    children.append("C1");
+    tag.addFrame(new ID3v2::TableOfContentsFrame("T", children));
+
+    const ByteVector data = tag.render();
+    LazyFrameFactory factory;
+    CPPUNIT_ASSERT(factory.lazyParsing());
+
+    {
+      // Rendering an untouched tag parses the frames.
+
+      ByteVectorStream stream(data);
+      MPEG::File f(&stream, &factory, false);
+      CPPUNIT_ASSERT_EQUAL(String("Title"), f.ID3v2Tag()->title());
+      CPPUNIT_ASSERT_EQUAL(data, f.ID3v2Tag()->render());
+    }
+    {
+      ByteVectorStream stream(data);
+      MPEG::File f(&stream, &factory, false);
+      ID3v2::Tag *t = f.ID3v2Tag();
+
+      ID3v2::AttachedPictureFrame *apic2 =
+        dynamic_cast<ID3v2::AttachedPictureFrame *>(t->frameList("APIC").front());
+      CPPUNIT_ASSERT(apic2);
+      CPPUNIT_ASSERT_EQUAL(String("image/png"), apic2->mimeType());
+      CPPUNIT_ASSERT_EQUAL(String("Cover"), apic2->description());
+      CPPUNIT_ASSERT_EQUAL(ByteVector("picture data"), apic2->picture());
+
+      ID3v2::GeneralEncapsulatedObjectFrame *geob2 =
+        dynamic_cast<ID3v2::GeneralEncapsulatedObjectFrame *>(t->frameList("GEOB").front());
+      CPPUNIT_ASSERT(geob2);
+      CPPUNIT_ASSERT_EQUAL(String("notes.txt"), geob2->fileName());
+      CPPUNIT_ASSERT_EQUAL(ByteVector("object data"), geob2->object());
+
+      ID3v2::SynchronizedLyricsFrame *sylt2 =
+        dynamic_cast<ID3v2::SynchronizedLyricsFrame *>(t->frameList("SYLT").front());
+      CPPUNIT_ASSERT(sylt2);
+      CPPUNIT_ASSERT_EQUAL(2U, sylt2->synchedText().size());
+      CPPUNIT_ASSERT_EQUAL(String("second"), sylt2->synchedText()[1].text);
+
+      ID3v2::ChapterFrame *chap = ID3v2::ChapterFrame::findByElementID(t, "C1");
+      CPPUNIT_ASSERT(chap);
+      CPPUNIT_ASSERT_EQUAL(1000U, chap->endTime());
+      CPPUNIT_ASSERT_EQUAL(String("Chapter 1"), chap->embeddedFrameList("TIT2").front()->toString());
+
+      ID3v2::TableOfContentsFrame *ctoc = ID3v2::TableOfContentsFrame::findByElementID(t, "T");
+      CPPUNIT_ASSERT(ctoc);
+      CPPUNIT_ASSERT_EQUAL(1U, ctoc->entryCount());
+      CPPUNIT_ASSERT_EQUAL(ByteVector("C1"), ctoc->childElements().front());
+    }
+    {
+      // A setter must not be undone by the parsing it triggers.
+
+      ByteVectorStream stream(data);
+      MPEG::File f(&stream, &factory, false);
+      ID3v2::AttachedPictureFrame *apic2 =
+        static_cast<ID3v2::AttachedPictureFrame *>(f.ID3v2Tag()->frameList("APIC").front());
+      apic2->setDescription("Back");
+      CPPUNIT_ASSERT_EQUAL(String("Back"), apic2->description());
+      CPPUNIT_ASSERT_EQUAL(String("image/png"), apic2->mimeType());
+    }
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestID3v2);
@@ -24,6 +24,8 @@
  ***************************************************************************/
 
 #include <tlist.h>
+#include <tstring.h>
+#include <utility>
 #include <cppunit/extensions/HelperMacros.h>
 
 using namespace std;
@@ -34,6 +36,7 @@ class TestList : public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(TestList);
   CPPUNIT_TEST(testAppend);
   CPPUNIT_TEST(testDetach);
+  CPPUNIT_TEST(testMove);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -71,6 +74,30 @@ public:
     CPPUNIT_ASSERT_EQUAL(33, l2[2]);
   }
 
+  void testMove()
+  {
+#ifdef TAGLIB_MOVE_SEMANTICS
+    List<String> l1;
+    String s("abc");
+    l1.append(std::move(s));
+    l1.prepend(String("xyz"));
+    CPPUNIT_ASSERT(s.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(2U, l1.size());
+    CPPUNIT_ASSERT_EQUAL(String("abc"), l1.back());
+
+    List<String> l2(std::move(l1));
+    CPPUNIT_ASSERT(l1.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(2U, l2.size());
+
+    l1.append(String("def"));
+    CPPUNIT_ASSERT_EQUAL(1U, l1.size());
+
+    l1 = std::move(l2);
+    CPPUNIT_ASSERT_EQUAL(2U, l1.size());
+    CPPUNIT_ASSERT(l2.isEmpty());
+#endif
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestList);
@@ -0,0 +1,128 @@
+/***************************************************************************
+    copyright            : (C) 2026 by the TagLib developers
+    email                :
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include <tfilestream.h>
+#include <tmemorymappedstream.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "utils.h"
+
+using namespace std;
+using namespace TagLib;
+
+class TestMemoryMappedStream : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestMemoryMappedStream);
+  CPPUNIT_TEST(testReadBlock);
+  CPPUNIT_TEST(testSeek);
+  CPPUNIT_TEST(testReadOnly);
+  CPPUNIT_TEST(testEmptyFile);
+  CPPUNIT_TEST(testMissingFile);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void testReadBlock()
+  {
+    FileStream file(TEST_FILE_PATH_C("empty.ogg"), true);
+    MemoryMappedStream stream(TEST_FILE_PATH_C("empty.ogg"));
+    CPPUNIT_ASSERT(stream.isOpen());
+    CPPUNIT_ASSERT_EQUAL(4328L, stream.length());
+
+    CPPUNIT_ASSERT_EQUAL(file.readBlock(4), stream.readBlock(4));
+    CPPUNIT_ASSERT_EQUAL(4L, stream.tell());
+    CPPUNIT_ASSERT_EQUAL(file.readBlock(1000), stream.readBlock(1000));
+    CPPUNIT_ASSERT_EQUAL(1004L, stream.tell());
+
+    stream.seek(-28, IOStream::End);
+    const ByteVector tail = stream.readBlock(1024);
+    CPPUNIT_ASSERT_EQUAL(28U, tail.size());
+    CPPUNIT_ASSERT_EQUAL(4328L, stream.tell());
+    CPPUNIT_ASSERT(stream.readBlock(1024).isEmpty());
+  }
+
+  void testSeek()
+  {
+    MemoryMappedStream stream(TEST_FILE_PATH_C("empty.ogg"));
+    CPPUNIT_ASSERT_EQUAL(0L, stream.tell());
+
+    stream.seek(100, IOStream::Beginning);
+    CPPUNIT_ASSERT_EQUAL(100L, stream.tell());
+    stream.seek(100, IOStream::Current);
+    CPPUNIT_ASSERT_EQUAL(200L, stream.tell());
+    stream.seek(-300, IOStream::Current);
+    CPPUNIT_ASSERT_EQUAL(200L, stream.tell());
+
+    stream.seek(-100, IOStream::End);
+    CPPUNIT_ASSERT_EQUAL(4228L, stream.tell());
+    stream.seek(300, IOStream::Current);
+    CPPUNIT_ASSERT_EQUAL(4528L, stream.tell());
+    CPPUNIT_ASSERT(stream.readBlock(10).isEmpty());
+  }
+
+  void testReadOnly()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+    string name = copy.fileName();
+
+    {
+      MemoryMappedStream stream(name.c_str());
+      CPPUNIT_ASSERT(stream.readOnly());
+
+      stream.writeBlock(ByteVector("abcd"));
+      stream.insert(ByteVector("abcd"), 10);
+      stream.removeBlock(0, 10);
+      stream.truncate(10);
+      CPPUNIT_ASSERT_EQUAL(4328L, stream.length());
+    }
+    CPPUNIT_ASSERT(fileEqual(name, TEST_FILE_PATH_C("empty.ogg")));
+  }
+
+  void testEmptyFile()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+    string name = copy.fileName();
+
+    {
+      FileStream file(name.c_str());
+      file.truncate(0);
+    }
+    {
+      MemoryMappedStream stream(name.c_str());
+      CPPUNIT_ASSERT(stream.isOpen());
+      CPPUNIT_ASSERT_EQUAL(0L, stream.length());
+      CPPUNIT_ASSERT(stream.readBlock(10).isEmpty());
+    }
+  }
+
+  void testMissingFile()
+  {
+    MemoryMappedStream stream("/does/not/exist");
+    CPPUNIT_ASSERT(!stream.isOpen());
+    CPPUNIT_ASSERT(stream.readBlock(10).isEmpty());
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestMemoryMappedStream);
@@ -29,11 +29,13 @@
 #include <tpropertymap.h>
 #include <mpegfile.h>
 #include <id3v2tag.h>
+#include <id3v2framefactory.h>
 #include <id3v1tag.h>
 #include <apetag.h>
 #include <mpegproperties.h>
 #include <xingheader.h>
 #include <mpegheader.h>
+#include <tbytevectorstream.h>
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
 
@@ -46,7 +48,10 @@ class TestMPEG : public CppUnit::TestFixture
   CPPUNIT_TEST(testAudioPropertiesXingHeaderCBR);
   CPPUNIT_TEST(testAudioPropertiesXingHeaderVBR);
   CPPUNIT_TEST(testAudioPropertiesVBRIHeader);
+  CPPUNIT_TEST(testLameTag);
   CPPUNIT_TEST(testAudioPropertiesNoVBRHeaders);
+  CPPUNIT_TEST(testAudioPropertiesAccurateVBR);
+  CPPUNIT_TEST(testFrameIndex);
   CPPUNIT_TEST(testSkipInvalidFrames1);
   CPPUNIT_TEST(testSkipInvalidFrames2);
   CPPUNIT_TEST(testSkipInvalidFrames3);
@@ -65,6 +70,7 @@ class TestMPEG : public CppUnit::TestFixture
   CPPUNIT_TEST(testEmptyID3v1);
   CPPUNIT_TEST(testEmptyAPE);
   CPPUNIT_TEST(testIgnoreGarbage);
+  CPPUNIT_TEST(testGarbageBeforeID3v2);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -95,6 +101,72 @@ public:
     CPPUNIT_ASSERT_EQUAL(MPEG::XingHeader::Xing, f.audioProperties()->xingHeader()->type());
   }
 
+  void testLameTag()
+  {
+    MPEG::File f1(TEST_FILE_PATH_C("lame_cbr.mp3"));
+    CPPUNIT_ASSERT(f1.audioProperties());
+    CPPUNIT_ASSERT_EQUAL(576, f1.audioProperties()->encoderDelay());
+    CPPUNIT_ASSERT_EQUAL(576, f1.audioProperties()->encoderPadding());
+
+    const MPEG::XingHeader *xing = f1.audioProperties()->xingHeader();
+    CPPUNIT_ASSERT(xing->hasLameTag());
+    CPPUNIT_ASSERT_EQUAL(String("LAME3.99r"), xing->encoderVersion());
+    CPPUNIT_ASSERT_EQUAL(100U, xing->tableOfContents().size());
+    CPPUNIT_ASSERT_EQUAL(57, xing->quality());
+    CPPUNIT_ASSERT_EQUAL(16500, xing->lowpassFilter());
+    CPPUNIT_ASSERT(xing->hasTrackGain());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-3.4, xing->trackGain(), 0.001);
+    CPPUNIT_ASSERT(!xing->hasAlbumGain());
+    CPPUNIT_ASSERT_EQUAL(15097520U, xing->musicLength());
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(0x78bb), xing->musicCRC());
+
+    MPEG::File f2(TEST_FILE_PATH_C("lame_vbr.mp3"));
+    CPPUNIT_ASSERT(f2.audioProperties());
+    CPPUNIT_ASSERT_EQUAL(576, f2.audioProperties()->encoderDelay());
+    CPPUNIT_ASSERT_EQUAL(576, f2.audioProperties()->encoderPadding());
+    CPPUNIT_ASSERT_EQUAL(50, f2.audioProperties()->xingHeader()->quality());
+    CPPUNIT_ASSERT_EQUAL(17000, f2.audioProperties()->xingHeader()->lowpassFilter());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-3.9, f2.audioProperties()->xingHeader()->trackGain(), 0.001);
+
+
+    // A Xing header without a table of contents, so the Lame tag follows the
+    // quality indicator right away.
+
+    ByteVector data(32, '\0');
+    data.append(ByteVector("Xing\x00\x00\x00\x0b", 8));
+    data.append(ByteVector::fromUInt(1000));
+    data.append(ByteVector::fromUInt(400000));
+    data.append(ByteVector::fromUInt(78));
+    data.append(ByteVector("LAME3.100\x24\xc8", 11));
+    data.append(ByteVector::fromUInt(0x800000));
+    data.append(ByteVector("\x2c\x0f\x4e\x14\x00\x80\x45\x13\xe8\x00\x00\x00\x00", 13));
+    data.append(ByteVector::fromUInt(399000));
+    data.append(ByteVector("\x12\x34\x00\x00", 4));
+
+    const MPEG::XingHeader header(data);
+    CPPUNIT_ASSERT(header.isValid());
+    CPPUNIT_ASSERT_EQUAL(1000U, header.totalFrames());
+    CPPUNIT_ASSERT_EQUAL(400000U, header.totalSize());
+    CPPUNIT_ASSERT(header.tableOfContents().isEmpty());
+    CPPUNIT_ASSERT_EQUAL(78, header.quality());
+    CPPUNIT_ASSERT(header.hasLameTag());
+    CPPUNIT_ASSERT_EQUAL(String("LAME3.100"), header.encoderVersion());
+    CPPUNIT_ASSERT_EQUAL(20000, header.lowpassFilter());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, header.peakSignalAmplitude(), 0.0001);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, header.trackGain(), 0.001);
+    CPPUNIT_ASSERT(header.hasAlbumGain());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-2.0, header.albumGain(), 0.001);
+    CPPUNIT_ASSERT_EQUAL(1105U, header.startPadding());
+    CPPUNIT_ASSERT_EQUAL(1000U, header.endPadding());
+    CPPUNIT_ASSERT_EQUAL(399000U, header.musicLength());
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(0x1234), header.musicCRC());
+
+    const MPEG::XingHeader truncated(data.mid(0, data.size() - 1));
+    CPPUNIT_ASSERT(truncated.isValid());
+    CPPUNIT_ASSERT(!truncated.hasLameTag());
+    CPPUNIT_ASSERT_EQUAL(0U, truncated.startPadding());
+  }
+
   void testAudioPropertiesVBRIHeader()
   {
     MPEG::File f(TEST_FILE_PATH_C("rare_frames.mp3"));
@@ -127,6 +199,99 @@ public:
     CPPUNIT_ASSERT_EQUAL(209, lastHeader.frameLength());
   }
 
+  void testAudioPropertiesAccurateVBR()
+  {
+    // 50 frames of 128 kb/s and 50 frames of 320 kb/s, MPEG-1 layer III at
+    // 44.1 kHz, without a VBR header and with some garbage in between.
+
+    ByteVector data;
+    for(int i = 0; i < 100; ++i) {
+      ByteVector frame(i % 2 == 0 ? 417 : 1044, '\0');
+      frame[0] = '\xff';
+      frame[1] = '\xfb';
+      frame[2] = (i % 2 == 0) ? '\x90' : '\xe0';
+      data.append(frame);
+      if(i == 60)
+        data.append(ByteVector("junk data!", 10));
+    }
+
+    ByteVectorStream average(data);
+    MPEG::File f1(&average, ID3v2::FrameFactory::instance(), true, MPEG::Properties::Average);
+    CPPUNIT_ASSERT(f1.audioProperties());
+    CPPUNIT_ASSERT_EQUAL(128, f1.audioProperties()->bitrate());
+
+    ByteVectorStream accurate(data);
+    MPEG::File f2(&accurate, ID3v2::FrameFactory::instance(), true, MPEG::Properties::Accurate);
+    CPPUNIT_ASSERT(f2.audioProperties());
+    CPPUNIT_ASSERT_EQUAL(2612, f2.audioProperties()->lengthInMilliseconds());
+    CPPUNIT_ASSERT_EQUAL(224, f2.audioProperties()->bitrate());
+    CPPUNIT_ASSERT_EQUAL(2, f2.audioProperties()->channels());
+    CPPUNIT_ASSERT_EQUAL(44100, f2.audioProperties()->sampleRate());
+  }
+
+  void testFrameIndex()
+  {
+    // The same stream as in testAudioPropertiesAccurateVBR().
+
+    ByteVector data;
+    for(int i = 0; i < 100; ++i) {
+      ByteVector frame(i % 2 == 0 ? 417 : 1044, '\0');
+      frame[0] = '\xff';
+      frame[1] = '\xfb';
+      frame[2] = (i % 2 == 0) ? '\x90' : '\xe0';
+      data.append(frame);
+      if(i == 60)
+        data.append(ByteVector("junk data!", 10));
+    }
+
+    ByteVectorStream stream(data);
+    MPEG::File f(&stream, ID3v2::FrameFactory::instance(), false);
+
+    const MPEG::FrameIndex index = f.frameIndex();
+    CPPUNIT_ASSERT_EQUAL(100U, index.size());
+    CPPUNIT_ASSERT_EQUAL(1U, index.interval());
+    CPPUNIT_ASSERT_EQUAL(44100, index.sampleRate());
+    CPPUNIT_ASSERT_EQUAL(100LL, index.frameCount());
+    CPPUNIT_ASSERT_EQUAL(115200LL, index.sampleCount());
+    CPPUNIT_ASSERT_EQUAL(73050LL, index.streamLength());
+    CPPUNIT_ASSERT_EQUAL(0L, index.entry(0).offset);
+    CPPUNIT_ASSERT_EQUAL(417, index.entry(0).length);
+    CPPUNIT_ASSERT_EQUAL(44257L, index.entry(61).offset);
+    CPPUNIT_ASSERT_EQUAL(1044, index.entry(61).length);
+    CPPUNIT_ASSERT_EQUAL(70272LL, index.entry(61).sample);
+    CPPUNIT_ASSERT_EQUAL(-1L, index.entry(100).offset);
+    CPPUNIT_ASSERT_EQUAL(27759L, index.findTime(1000).offset);
+    CPPUNIT_ASSERT_EQUAL(0L, index.findTime(-5).offset);
+    CPPUNIT_ASSERT_EQUAL(72016L, index.findTime(1000000).offset);
+
+    const MPEG::FrameIndex sparse = f.frameIndex(10);
+    CPPUNIT_ASSERT_EQUAL(10U, sparse.size());
+    CPPUNIT_ASSERT_EQUAL(115200LL, sparse.sampleCount());
+    CPPUNIT_ASSERT_EQUAL(21915L, sparse.findTime(1000).offset);
+    CPPUNIT_ASSERT_EQUAL(34560LL, sparse.findTime(1000).sample);
+
+    const MPEG::FrameIndex totals = f.frameIndex(0);
+    CPPUNIT_ASSERT(totals.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(100LL, totals.frameCount());
+    CPPUNIT_ASSERT_EQUAL(-1L, totals.findTime(1000).offset);
+
+    const ByteVector rendered = index.render();
+    const MPEG::FrameIndex restored(rendered);
+    CPPUNIT_ASSERT_EQUAL(100U, restored.size());
+    CPPUNIT_ASSERT_EQUAL(44100, restored.sampleRate());
+    CPPUNIT_ASSERT_EQUAL(115200LL, restored.sampleCount());
+    CPPUNIT_ASSERT_EQUAL(73050LL, restored.streamLength());
+    for(unsigned int i = 0; i < index.size(); ++i) {
+      CPPUNIT_ASSERT_EQUAL(index.entry(i).offset, restored.entry(i).offset);
+      CPPUNIT_ASSERT_EQUAL(index.entry(i).length, restored.entry(i).length);
+      CPPUNIT_ASSERT_EQUAL(index.entry(i).sample, restored.entry(i).sample);
+    }
+    CPPUNIT_ASSERT_EQUAL(rendered, restored.render());
+
+    CPPUNIT_ASSERT(MPEG::FrameIndex(rendered.mid(0, rendered.size() - 1)).isEmpty());
+    CPPUNIT_ASSERT(MPEG::FrameIndex(ByteVector("junk data!")).isEmpty());
+  }
+
   void testSkipInvalidFrames1()
   {
     MPEG::File f(TEST_FILE_PATH_C("invalid-frames1.mp3"));
@@ -316,9 +481,10 @@ public:
       MPEG::File f(copy.fileName().c_str());
       f.ID3v2Tag(true)->setTitle("");
       f.save();
+      const long offset = f.firstFrameOffset();
       f.ID3v2Tag(true)->setTitle(std::string(4096, 'X').c_str());
       f.save();
-      CPPUNIT_ASSERT_EQUAL(5141L, f.firstFrameOffset());
+      CPPUNIT_ASSERT_EQUAL(alignedLength(offset, 5141, f.resizeAlignment()), f.firstFrameOffset());
     }
   }
 
@@ -438,6 +604,34 @@ public:
     }
   }
 
+  void testGarbageBeforeID3v2()
+  {
+    // The tag identifier crosses the boundary of the blocks in which the
+    // file is scanned, and the garbage has frame synchs in it.
+
+    ID3v2::Tag tag;
+    tag.setTitle("Title A");
+    const ByteVector tagData = tag.render();
+
+    ByteVector data(1022, '\xff');
+    data.append(tagData);
+    for(int i = 0; i < 10; ++i) {
+      ByteVector frame(417, '\0');
+      frame[0] = '\xff';
+      frame[1] = '\xfb';
+      frame[2] = '\x90';
+      data.append(frame);
+    }
+
+    ByteVectorStream stream(data);
+    MPEG::File f(&stream, ID3v2::FrameFactory::instance());
+    CPPUNIT_ASSERT(f.isValid());
+    CPPUNIT_ASSERT(f.hasID3v2Tag());
+    CPPUNIT_ASSERT_EQUAL(String("Title A"), f.ID3v2Tag()->title());
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(1022 + tagData.size()), f.firstFrameOffset());
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(1022 + tagData.size() + 9 * 417), f.lastFrameOffset());
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestMPEG);
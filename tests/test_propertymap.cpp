@@ -36,6 +36,7 @@ class TestPropertyMap : public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(TestPropertyMap);
   CPPUNIT_TEST(testInvalidKeys);
   CPPUNIT_TEST(testGetSet);
+  CPPUNIT_TEST(testMove);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -96,6 +97,27 @@ public:
     CPPUNIT_ASSERT_EQUAL(0U, tag.track());
   }
 
+  void testMove()
+  {
+#ifdef TAGLIB_MOVE_SEMANTICS
+    PropertyMap map1;
+    map1["ARTIST"] = String("Test Artist");
+    map1.unsupportedData().append("APIC");
+
+    PropertyMap map2(std::move(map1));
+    CPPUNIT_ASSERT(map1.isEmpty());
+    CPPUNIT_ASSERT(map1.unsupportedData().isEmpty());
+    CPPUNIT_ASSERT_EQUAL(String("Test Artist"), map2["ARTIST"].front());
+    CPPUNIT_ASSERT_EQUAL(StringList("APIC"), map2.unsupportedData());
+
+    map1 = std::move(map2);
+    CPPUNIT_ASSERT(map2.isEmpty());
+    CPPUNIT_ASSERT(map2.unsupportedData().isEmpty());
+    CPPUNIT_ASSERT_EQUAL(String("Test Artist"), map1["ARTIST"].front());
+    CPPUNIT_ASSERT_EQUAL(StringList("APIC"), map1.unsupportedData());
+#endif
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestPropertyMap);
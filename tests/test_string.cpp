@@ -24,8 +24,15 @@
  ***************************************************************************/
 
 #include <tstring.h>
+#include <tstringlist.h>
 #include <string.h>
+#include <utility>
 #include <cppunit/extensions/HelperMacros.h>
+#include "utils.h"
+
+#ifdef HAVE_STD_THREAD
+# include <thread>
+#endif
 
 using namespace std;
 using namespace TagLib;
@@ -52,6 +59,10 @@ class TestString : public CppUnit::TestFixture
   CPPUNIT_TEST(testEncodeNonBMP);
   CPPUNIT_TEST(testIterator);
   CPPUNIT_TEST(testInvalidUTF8);
+  CPPUNIT_TEST(testEmptyAndMove);
+  CPPUNIT_TEST(testUndecodedUTF8);
+  CPPUNIT_TEST(testMixedASCII);
+  CPPUNIT_TEST(testSharedUndecodedUTF8);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -366,6 +377,136 @@ public:
     CPPUNIT_ASSERT(String(ByteVector("\xED\xB0\x80\xED\xA0\x80"), String::UTF8).isEmpty());
   }
 
+  void testEmptyAndMove()
+  {
+    String s1;
+    String s2;
+    s1 += 'a';
+    CPPUNIT_ASSERT_EQUAL(String("a"), s1);
+    CPPUNIT_ASSERT(s2.isEmpty());
+    CPPUNIT_ASSERT(!s2.isNull());
+    CPPUNIT_ASSERT_EQUAL(std::string(), std::string(s2.toCString()));
+    CPPUNIT_ASSERT(String().upper().isEmpty());
+
+#ifdef TAGLIB_MOVE_SEMANTICS
+    String s3(std::move(s1));
+    CPPUNIT_ASSERT_EQUAL(String("a"), s3);
+    CPPUNIT_ASSERT(s1.isEmpty());
+
+    s1 += 'b';
+    CPPUNIT_ASSERT_EQUAL(String("b"), s1);
+
+    s2 = std::move(s3);
+    CPPUNIT_ASSERT_EQUAL(String("a"), s2);
+    CPPUNIT_ASSERT(s3.isEmpty());
+#endif
+  }
+
+  void testUndecodedUTF8()
+  {
+    const ByteVector utf8("\x61\xC3\xA9\xF0\x9D\x84\x9E\x62");
+    const wchar_t utf16[] = { L'a', 0x00E9, 0xD834, 0xDD1E, L'b', 0 };
+
+    const String s1(utf8, String::UTF8);
+    CPPUNIT_ASSERT_EQUAL(5U, s1.size());
+    CPPUNIT_ASSERT(!s1.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(utf8, s1.data(String::UTF8));
+    CPPUNIT_ASSERT_EQUAL(std::string(utf8.data(), utf8.size()), s1.to8Bit(true));
+
+    String s2 = s1;
+    CPPUNIT_ASSERT(s1 == s2);
+    CPPUNIT_ASSERT(s2 == String(utf16));
+    CPPUNIT_ASSERT(String(utf16) == s1);
+    CPPUNIT_ASSERT_EQUAL(5U, s1.size());
+
+    s2[0] = L'c';
+    CPPUNIT_ASSERT_EQUAL(String(L"c") + s1.substr(1), s2);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("\x63\xC3\xA9\xF0\x9D\x84\x9E\x62"), s2.data(String::UTF8));
+    CPPUNIT_ASSERT_EQUAL(utf8, s1.data(String::UTF8));
+
+    String s3(std::string("x\xC3\xA9"), String::UTF8);
+    s3 += 'y';
+    CPPUNIT_ASSERT_EQUAL(String(L"x\x00E9y"), s3);
+
+    const String s4(ByteVector("ab\0cd", 5), String::UTF8);
+    CPPUNIT_ASSERT_EQUAL(String("ab"), s4);
+    CPPUNIT_ASSERT_EQUAL(2U, s4.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("ab"), std::string(s4.toCString(true)));
+
+    CPPUNIT_ASSERT(String(ByteVector("\xC3"), String::UTF8).isEmpty());
+  }
+
+  void testMixedASCII()
+  {
+    // Runs of ASCII of different lengths around non-ASCII characters.
+
+    const ByteVector utf8("abcdefghijklmnopqrst\xC3\xA9uvwxyz012\xF0\x9D\x84\x9E\xE2\x82\xAC" "3456789");
+    wstring utf16(L"abcdefghijklmnopqrst");
+    utf16 += wchar_t(0x00E9);
+    utf16 += L"uvwxyz012";
+    utf16 += wchar_t(0xD834);
+    utf16 += wchar_t(0xDD1E);
+    utf16 += wchar_t(0x20AC);
+    utf16 += L"3456789";
+
+    const String s(utf16);
+    CPPUNIT_ASSERT_EQUAL(utf8, s.data(String::UTF8));
+    CPPUNIT_ASSERT(String(utf8, String::UTF8).toWString() == utf16);
+    CPPUNIT_ASSERT(String(std::string(utf8.data(), utf8.size()), String::UTF8).toWString() == utf16);
+
+    for(int t = String::UTF16; t <= String::UTF16LE; ++t) {
+      if(t == String::UTF8)
+        continue;
+      const ByteVector v = s.data(String::Type(t));
+      CPPUNIT_ASSERT_EQUAL(s, String(v, String::Type(t)));
+    }
+
+    const String latin1(ByteVector("abcdefghij\xE9klmnopq"), String::Latin1);
+    CPPUNIT_ASSERT_EQUAL(wchar_t(0xE9), latin1[10]);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("abcdefghij\xE9klmnopq"), latin1.data(String::Latin1));
+
+    CPPUNIT_ASSERT(String(ByteVector("abcdefghij\xE9klmnopq"), String::UTF8).isEmpty());
+    CPPUNIT_ASSERT(String(wstring(L"abcdefghij") + wchar_t(0xD834) + L"klm").data(String::UTF8).isEmpty());
+  }
+
+  void testSharedUndecodedUTF8()
+  {
+#ifdef HAVE_STD_THREAD
+    // Copies of a list share its strings, so threads reading their own copy
+    // decode the same undecoded string at once.
+
+    const wchar_t utf16[] = { L'a', 0x00E9, 0xD834, 0xDD1E, L'b', 0 };
+    const wstring expected(utf16);
+
+    for(int i = 0; i < 100; ++i) {
+      StringList a;
+      for(int j = 0; j < 100; ++j)
+        a.append(String(ByteVector("\x61\xC3\xA9\xF0\x9D\x84\x9E\x62"), String::UTF8));
+      StringList b = a;
+
+      bool ok1 = false;
+      bool ok2 = false;
+      std::thread t1(readStrings, &a, &expected, &ok1);
+      std::thread t2(readStrings, &b, &expected, &ok2);
+      t1.join();
+      t2.join();
+      CPPUNIT_ASSERT(ok1);
+      CPPUNIT_ASSERT(ok2);
+    }
+#endif
+  }
+
+private:
+
+  static void readStrings(const StringList *list, const wstring *expected, bool *ok)
+  {
+    *ok = true;
+    for(StringList::ConstIterator it = list->begin(); it != list->end(); ++it) {
+      if(it->isLatin1() || wstring(it->toCWString()) != *expected || it->toWString() != *expected)
+        *ok = false;
+    }
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestString);
@@ -42,6 +42,8 @@ class TestID3v2SynchData : public CppUnit::TestFixture
   CPPUNIT_TEST(testDecode2);
   CPPUNIT_TEST(testDecode3);
   CPPUNIT_TEST(testDecode4);
+  CPPUNIT_TEST(testEncode);
+  CPPUNIT_TEST(testEncodeDecodeLong);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -122,6 +124,35 @@ public:
     CPPUNIT_ASSERT_EQUAL(ByteVector("\xff\xff\xff", 3), a);
   }
 
+  void testEncode()
+  {
+    CPPUNIT_ASSERT_EQUAL(ByteVector("\xff\x00\x00", 3),
+                         ID3v2::SynchData::encode(ByteVector("\xff\x00", 2)));
+    CPPUNIT_ASSERT_EQUAL(ByteVector("\xff\x00\xe0", 3),
+                         ID3v2::SynchData::encode(ByteVector("\xff\xe0", 2)));
+    CPPUNIT_ASSERT_EQUAL(ByteVector("\xff\x44", 2),
+                         ID3v2::SynchData::encode(ByteVector("\xff\x44", 2)));
+    CPPUNIT_ASSERT_EQUAL(ByteVector("\x01\xff\x00", 3),
+                         ID3v2::SynchData::encode(ByteVector("\x01\xff", 2)));
+    CPPUNIT_ASSERT_EQUAL(ByteVector("\xff\x00\xff\x00\xff\x00", 6),
+                         ID3v2::SynchData::encode(ByteVector("\xff\xff\xff", 3)));
+    CPPUNIT_ASSERT_EQUAL(ByteVector(), ID3v2::SynchData::encode(ByteVector()));
+  }
+
+  void testEncodeDecodeLong()
+  {
+    ByteVector data(10000, 0);
+    for(unsigned int i = 0; i < data.size(); ++i)
+      data[i] = static_cast<char>((i * 7919) % 253 == 0 ? 0xff : (i * 31) % 256);
+
+    const ByteVector encoded = ID3v2::SynchData::encode(data);
+    for(unsigned int i = 0; i + 1 < encoded.size(); ++i) {
+      if(encoded[i] == '\xff')
+        CPPUNIT_ASSERT((static_cast<unsigned char>(encoded[i + 1]) & 0xe0) != 0xe0);
+    }
+    CPPUNIT_ASSERT_EQUAL(data, ID3v2::SynchData::decode(encoded));
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestID3v2SynchData);
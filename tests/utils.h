@@ -69,6 +69,20 @@ inline string copyFile(const string &filename, const string &ext)
   return string(testFileName);
 }
 
+// Returns the length that a file of originalLength bytes, which a save grows
+// to unalignedLength bytes without rounding, has when its growth is rounded
+// up to a multiple of alignment, as the formats do if File::resizeAlignment()
+// is non-zero.
+
+inline long alignedLength(long originalLength, long unalignedLength, long alignment)
+{
+  if(alignment <= 0 || unalignedLength <= originalLength)
+    return unalignedLength;
+
+  const long growth = unalignedLength - originalLength;
+  return originalLength + (growth + alignment - 1) / alignment * alignment;
+}
+
 inline void deleteFile(const string &filename)
 {
   remove(filename.c_str());